@@ -0,0 +1,450 @@
+// arena.c
+// 두 엔진 설정을 서버 없이 맞붙이는 로컬 대국장
+// 오프닝마다 무작위 수를 -random 수 둔 뒤 색을 바꿔 두 판을 두고, 설정 A 기준 승/무/패와
+// Elo 차이, 설정별 평균 nps를 낸다
+//
+// 프로세스 구성: 부모 -> 심판 워커 -workers개 -> 워커마다 엔진 A, B 프로세스
+// 엔진 프로세스는 g_config를 따로 가지고 client와 같은 generate_move로 수를 고르며,
+// 심판은 파이프로 국면을 보내고 -time 초 안에 답이 없으면 시간패로 처리한 뒤 엔진을 새로 띄운다
+#ifdef ARENA_STANDALONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "engine.h"
+
+// 둘 수 있는 수가 계속 남아도 (점프만 오가는 경우) 이 수에서 말 개수로 끝낸다
+#define ARENA_MAX_PLIES 400
+
+// 심판 -> 엔진. side < 0이면 대국 끝 (답하지 않음)
+typedef struct ArenaRequest {
+    Position pos;
+    int      side;
+    double   timeout;
+} ArenaRequest;
+
+// 엔진 -> 심판 (좌표는 generate_move와 같은 1-based, 둘 수 없으면 0)
+typedef struct ArenaReply {
+    int      sx, sy, tx, ty;
+    uint64_t nodes;
+} ArenaReply;
+
+// 워커 -> 부모, 한 판의 결과
+typedef struct GameResult {
+    int      a_side;        // 설정 A가 둔 색 (0 = 'R')
+    int      outcome;       // 설정 A 기준 1 승, 0 무, -1 패
+    int      forfeit;       // 시간패/반칙패한 설정 (0 = A, 1 = B, 없으면 -1)
+    int      plies;
+    int      count[2];      // 설정 A, B의 최종 말 수
+    uint64_t nodes[2];      // 설정 A, B
+    double   seconds[2];
+} GameResult;
+
+typedef struct Engine {
+    EngineConfig cfg;
+    pid_t        pid;
+    int          to_fd;
+    int          from_fd;
+} Engine;
+
+typedef struct Arena {
+    int          pairs;
+    int          workers;
+    int          random_plies;
+    int          max_plies;
+    double       time;
+    uint64_t     seed;
+    Position     start;
+    EngineConfig cfg[2];
+} Arena;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s [-games N] [-workers N] [-time SEC] [-random N] [-seed N] [-maxply N]\n"
+            "          [-board R......B/......../...] [-a-<engine option> V] [-b-<engine option> V]\n"
+            "  -a-, -b-로 시작하는 옵션은 client의 엔진 옵션을 설정 A, B에 준다 (예: -a-engine greedy)\n"
+            "Example:\n"
+            "  %s -games 1000 -workers 8 -time 0.5 -a-engine search -b-engine greedy\n",
+            progname, progname);
+}
+
+static int read_full(int fd, void *buf, size_t n) {
+    char *p = (char *)buf;
+    while (n > 0) {
+        ssize_t r = read(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return 0;
+        p += r;
+        n -= r;
+    }
+    return 1;
+}
+
+static int write_full(int fd, const void *buf, size_t n) {
+    const char *p = (const char *)buf;
+    while (n > 0) {
+        ssize_t r = write(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return 0;
+        p += r;
+        n -= r;
+    }
+    return 1;
+}
+
+// 국면 -> 서버가 보내는 것과 같은 8줄 보드 JSON 배열
+static cJSON *board_to_json(const Position *pos) {
+    cJSON *arr = cJSON_CreateArray();
+    for (int i = 0; i < SIZE; i++) {
+        char row[SIZE + 1];
+        for (int j = 0; j < SIZE; j++) {
+            uint64_t bit = 1ULL << (i * SIZE + j);
+            row[j] = (pos->bb[0] & bit) ? 'R' : (pos->bb[1] & bit) ? 'B' : (pos->empty & bit) ? '.' : '#';
+        }
+        row[SIZE] = '\0';
+        cJSON_AddItemToArray(arr, cJSON_CreateString(row));
+    }
+    return arr;
+}
+
+// 1-based 좌표 답 -> 수 (둘 수 없다는 답이거나 판 밖이면 MOVE_NONE)
+static Move reply_move(const ArenaReply *rep) {
+    int v[4] = { rep->sx, rep->sy, rep->tx, rep->ty };
+    for (int i = 0; i < 4; i++) {
+        if (v[i] < 1 || v[i] > SIZE) return MOVE_NONE;
+    }
+    return move_pack((v[0] - 1) * SIZE + v[1] - 1, (v[2] - 1) * SIZE + v[3] - 1);
+}
+
+// 엔진 프로세스 본체: client의 your_turn / move_ok 처리와 같은 순서로 엔진을 부른다
+static void engine_main(const EngineConfig *cfg, int in_fd, int out_fd) {
+    g_config = *cfg;
+    if (!engine_init(&g_config)) {
+        fprintf(stderr, "[대국장] 엔진 초기화 실패\n");
+        _exit(1);
+    }
+    // 치환표를 잡는 동안은 시간에 넣지 않도록 준비가 끝났음을 알린다
+    char ready = 1;
+    if (!write_full(out_fd, &ready, 1)) _exit(1);
+    ArenaRequest req;
+    while (read_full(in_fd, &req, sizeof(req))) {
+        if (req.side < 0) {
+            engine_ponder_stop();
+            continue;
+        }
+        char me = req.side ? 'B' : 'R';
+        cJSON *board = board_to_json(&req.pos);
+        ArenaReply rep;
+        memset(&rep, 0, sizeof(rep));
+        generate_move(board, req.timeout, &rep.sx, &rep.sy, &rep.tx, &rep.ty, me);
+        cJSON_Delete(board);
+        rep.nodes = g_stats.nodes;
+        if (!write_full(out_fd, &rep, sizeof(rep))) break;
+
+        // move_ok로 받을 보드로 상대 차례 탐색 (-ponder on일 때만 실제로 돈다)
+        Move mv = reply_move(&rep);
+        if (mv != MOVE_NONE) {
+            if (is_valid_move(&req.pos, mv, req.side)) {
+                apply_move(&req.pos, mv, req.side);
+                board = board_to_json(&req.pos);
+                engine_ponder_start(board, me);
+                cJSON_Delete(board);
+            }
+        }
+    }
+    engine_ponder_stop();
+    _exit(0);
+}
+
+static void engine_kill(Engine *e, bool force) {
+    if (e->pid <= 0) return;
+    if (force) kill(e->pid, SIGKILL);
+    close(e->to_fd);
+    close(e->from_fd);
+    waitpid(e->pid, NULL, 0);
+    e->pid = -1;
+}
+
+static int engine_spawn(Engine *e) {
+    int to[2], from[2];
+    if (pipe(to) != 0) return 0;
+    if (pipe(from) != 0) {
+        close(to[0]);
+        close(to[1]);
+        return 0;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(to[0]);
+        close(to[1]);
+        close(from[0]);
+        close(from[1]);
+        return 0;
+    }
+    if (pid == 0) {
+        // 워커의 다른 파이프(결과 파이프, 다른 엔진의 파이프)를 쥐고 있으면 EOF가 오지 않는다
+        for (int fd = 3; fd < 1024; fd++) {
+            if (fd != to[0] && fd != from[1]) close(fd);
+        }
+        engine_main(&e->cfg, to[0], from[1]);
+    }
+    close(to[0]);
+    close(from[1]);
+    e->pid = pid;
+    e->to_fd = to[1];
+    e->from_fd = from[0];
+    char ready;
+    if (!read_full(e->from_fd, &ready, 1)) {
+        engine_kill(e, true);
+        return 0;
+    }
+    return 1;
+}
+
+// 엔진에 수를 묻는다. 시간 안에 답하면 1, 시간을 넘기거나 엔진이 죽으면 0 (엔진은 새로 띄운다)
+static int engine_ask(Engine *e, const Position *pos, int side, double timeout, ArenaReply *rep, double *elapsed) {
+    ArenaRequest req = { *pos, side, timeout };
+    double start = now_sec();
+    bool ok = write_full(e->to_fd, &req, sizeof(req));
+    if (ok) {
+        struct pollfd pfd = { e->from_fd, POLLIN, 0 };
+        int left_ms = (int)ceil(timeout * 1000);
+        int r;
+        do {
+            r = poll(&pfd, 1, left_ms);
+            left_ms = (int)ceil((timeout - (now_sec() - start)) * 1000);
+        } while (r < 0 && errno == EINTR && left_ms > 0);
+        ok = r > 0 && read_full(e->from_fd, rep, sizeof(*rep));
+    }
+    *elapsed = now_sec() - start;
+    if (ok && *elapsed <= timeout) return 1;
+    engine_kill(e, true);
+    if (!engine_spawn(e)) _exit(1);
+    return 0;
+}
+
+// 대국 끝을 알린다 (상대 차례 탐색을 멈추게 한다)
+static void engine_game_over(Engine *e) {
+    ArenaRequest req;
+    memset(&req, 0, sizeof(req));
+    req.side = -1;
+    write_full(e->to_fd, &req, sizeof(req));
+}
+
+static inline uint64_t rng_next(uint64_t *s) {
+    return splitmix64(*s);
+}
+
+// 오프닝: 시작 국면에서 양쪽이 무작위 수를 random_plies 수 둔다 (둘 수 없으면 패스)
+static int make_opening(const Arena *a, uint64_t seed, Position *pos) {
+    *pos = a->start;
+    int side = 0;
+    for (int ply = 0; ply < a->random_plies; ply++) {
+        MoveList moves;
+        int cnt = gather_moves(pos, side, &moves);
+        if (cnt > 0) apply_move(pos, moves[rng_next(&seed) % cnt], side);
+        side ^= 1;
+    }
+    return side;
+}
+
+// 한 판. eng[0] = 설정 A, eng[1] = 설정 B, a_side = 설정 A의 색
+static void play_game(const Arena *a, Engine eng[2], const Position *opening, int first, int a_side, GameResult *res) {
+    Position pos = *opening;
+    int side = first;
+    memset(res, 0, sizeof(*res));
+    res->a_side = a_side;
+    res->forfeit = -1;
+    int loser = -1;         // 시간패/반칙패한 설정
+    int ply;
+    for (ply = 0; ply < a->max_plies; ply++) {
+        if (pos.count[0] == 0 || pos.count[1] == 0) break;
+        MoveList moves;
+        if (gather_moves(&pos, side, &moves) == 0) {
+            if (gather_moves(&pos, side ^ 1, &moves) == 0) break;
+            side ^= 1;      // 서버의 pass
+            continue;
+        }
+        int who = side == a_side ? 0 : 1;
+        ArenaReply rep;
+        double elapsed;
+        bool in_time = engine_ask(&eng[who], &pos, side, a->time, &rep, &elapsed);
+        res->seconds[who] += elapsed;
+        if (!in_time) {
+            loser = who;
+            break;
+        }
+        res->nodes[who] += rep.nodes;
+        Move mv = reply_move(&rep);
+        if (!is_valid_move(&pos, mv, side)) {
+            loser = who;    // 서버라면 invalid_move
+            break;
+        }
+        apply_move(&pos, mv, side);
+        side ^= 1;
+    }
+    engine_game_over(&eng[0]);
+    engine_game_over(&eng[1]);
+
+    res->plies = ply;
+    res->count[0] = pos.count[a_side];
+    res->count[1] = pos.count[a_side ^ 1];
+    if (loser >= 0) {
+        res->forfeit = loser;
+        res->outcome = loser == 0 ? -1 : 1;
+    } else {
+        res->outcome = (res->count[0] > res->count[1]) - (res->count[0] < res->count[1]);
+    }
+}
+
+// 워커 w는 오프닝 w, w + workers, ...를 맡아 색을 바꿔 두 판씩 두고 결과를 out_fd로 보낸다
+static void worker_main(const Arena *a, int w, int out_fd) {
+    Engine eng[2];
+    for (int i = 0; i < 2; i++) {
+        eng[i].cfg = a->cfg[i];
+        if (!engine_spawn(&eng[i])) _exit(1);
+    }
+    for (int p = w; p < a->pairs; p += a->workers) {
+        uint64_t seed = a->seed ^ (0x9e3779b97f4a7c15ULL * (p + 1));
+        Position opening;
+        int first = make_opening(a, seed, &opening);
+        for (int a_side = 0; a_side < 2; a_side++) {
+            GameResult res;
+            play_game(a, eng, &opening, first, a_side, &res);
+            // PIPE_BUF보다 작으므로 여러 워커가 같은 파이프에 써도 섞이지 않는다
+            if (!write_full(out_fd, &res, sizeof(res))) _exit(1);
+        }
+    }
+    engine_kill(&eng[0], false);
+    engine_kill(&eng[1], false);
+    _exit(0);
+}
+
+// 설정 A의 점수율 -> Elo 차이
+static double elo_diff(double score) {
+    if (score <= 0) return -INFINITY;
+    if (score >= 1) return INFINITY;
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+int main(int argc, char *argv[]) {
+    Arena a;
+    memset(&a, 0, sizeof(a));
+    const char *board = "R......B/......../......../......../......../......../......../B......R";
+    int games = 100;
+    a.workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    a.random_plies = 4;
+    a.max_plies = ARENA_MAX_PLIES;
+    a.time = 1.0;
+    a.seed = 1;
+    a.cfg[0] = a.cfg[1] = g_config;
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        const char *f = argv[i], *v = argv[i + 1];
+        if (strcmp(f, "-games") == 0)        games = atoi(v);
+        else if (strcmp(f, "-workers") == 0) a.workers = atoi(v);
+        else if (strcmp(f, "-time") == 0)    a.time = atof(v);
+        else if (strcmp(f, "-random") == 0)  a.random_plies = atoi(v);
+        else if (strcmp(f, "-seed") == 0)    a.seed = strtoull(v, NULL, 10);
+        else if (strcmp(f, "-maxply") == 0)  a.max_plies = atoi(v);
+        else if (strcmp(f, "-board") == 0)   board = v;
+        else if (strncmp(f, "-a-", 3) != 0 && strncmp(f, "-b-", 3) != 0) {
+            print_usage(argv[0]);
+            return 1;
+        } else if (!engine_parse_option(&a.cfg[f[1] == 'b'], f + 2, v)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (games <= 0 || a.workers <= 0 || a.time <= 0 || a.random_plies < 0 || a.max_plies <= 0 ||
+        strlen(board) != SIZE * (SIZE + 1) - 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) rows[i] = board + i * (SIZE + 1);
+    position_load(&a.start, rows);
+    a.pairs = (games + 1) / 2;
+    if (a.workers > a.pairs) a.workers = a.pairs;
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("파이프 생성 실패");
+        return 1;
+    }
+    printf("[대국장] %d판 (오프닝 %d개 x 색 바꿈), 워커 %d, 수마다 %.2f초\n", a.pairs * 2, a.pairs, a.workers, a.time);
+    fflush(stdout);
+    for (int w = 0; w < a.workers; w++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork 실패");
+            return 1;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            worker_main(&a, w, fds[1]);
+        }
+    }
+    close(fds[1]);
+
+    int wins = 0, draws = 0, losses = 0, forfeits[2] = { 0, 0 }, done = 0;
+    uint64_t nodes[2] = { 0, 0 };
+    double seconds[2] = { 0, 0 }, plies = 0;
+    GameResult res;
+    while (read_full(fds[0], &res, sizeof(res))) {
+        done++;
+        wins += res.outcome > 0;
+        draws += res.outcome == 0;
+        losses += res.outcome < 0;
+        if (res.forfeit >= 0) forfeits[res.forfeit]++;
+        plies += res.plies;
+        for (int i = 0; i < 2; i++) {
+            nodes[i] += res.nodes[i];
+            seconds[i] += res.seconds[i];
+        }
+        if (done % 10 == 0 || done == a.pairs * 2) {
+            printf("[대국장] %d/%d판: A 기준 %d승 %d무 %d패\n", done, a.pairs * 2, wins, draws, losses);
+            fflush(stdout);
+        }
+    }
+    close(fds[0]);
+    int status, failed = 0;
+    while (wait(&status) > 0) failed += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    if (done == 0) {
+        fprintf(stderr, "[대국장] 끝난 대국 없음\n");
+        return 1;
+    }
+
+    // 판마다 점수 1 / 0.5 / 0의 평균과 표준오차로 95% 구간
+    double score = (wins + 0.5 * draws) / done;
+    double var = (wins * (1 - score) * (1 - score) + draws * (0.5 - score) * (0.5 - score) +
+                  losses * score * score) / done;
+    double se = sqrt(var / done);
+    printf("[대국장] A 기준 %d승 %d무 %d패 (시간패/반칙패 A %d판, B %d판, 평균 %.1f수)\n", wins, draws, losses,
+           forfeits[0], forfeits[1], plies / done);
+    printf("[대국장] 점수율 %.1f%%, Elo 차이 %+.1f (95%% 구간 %+.1f .. %+.1f)\n", 100 * score, elo_diff(score),
+           elo_diff(score - 1.96 * se), elo_diff(score + 1.96 * se));
+    for (int i = 0; i < 2; i++) {
+        printf("[대국장] 설정 %c: 노드 %llu, 생각 %.1f초, 평균 %.0f nps\n", 'A' + i,
+               (unsigned long long)nodes[i], seconds[i], seconds[i] > 0 ? nodes[i] / seconds[i] : 0.0);
+    }
+    if (failed) fprintf(stderr, "[대국장] 비정상 종료한 워커 %d개\n", failed);
+    return failed != 0;
+}
+#endif
@@ -0,0 +1,311 @@
+// bench.c
+// 엔진 핫패스 마이크로벤치마크: 정해진 오프닝/미들게임/엔드게임 국면에서
+// gather_moves, apply_move, calc_greedy_value, is_safe_jump, evaluate_five_greedy, generate_move를
+// 재어 ns/op의 평균과 표준편차를 내고, 릴리스끼리 비교할 수 있게 JSON 파일로 남긴다
+//
+// 표본 하나 = 국면 묶음 전체를 -ms 밀리초쯤 되도록 반복한 것 (반복 수는 처음에 한 번 맞춘다)
+// op 단위: gather_moves / generate_move는 국면 하나, 나머지는 그 국면의 수 하나
+// generate_move는 호출마다 치환표를 비우고 (시간에 넣지 않음) timeout 없이 -depth까지 탐색한다
+// timeout이 없으면 종반 솔버는 증명될 때까지 읽으므로 -endgame을 따로 주지 않으면 끈다
+#ifdef BENCH_STANDALONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "engine.h"
+#include "tt.h"
+
+#define BENCH_MAX_POS 8
+
+enum { PHASE_OPENING, PHASE_MIDGAME, PHASE_ENDGAME, N_PHASES };
+
+static const char *const PHASE_NAMES[N_PHASES] = { "opening", "midgame", "endgame" };
+
+typedef struct BenchBoard {
+    int         phase;
+    const char *board;
+    char        side;
+} BenchBoard;
+
+// 시작 국면에서 그리디 위주로 둔 대국의 3, 9, 25, 35, 88, 99수째 (엔드게임은 빈칸 14, 8)
+static const BenchBoard CORPUS[] = {
+    { PHASE_OPENING, "R......B/......../......../......../......../......../......../B......R", 'R' },
+    { PHASE_OPENING, "R.....BB/R......./......../......../......../......../B.....R./B......R", 'R' },
+    { PHASE_OPENING, "R...B.BB/RR...B../......../......../......../B......./B....RRR/B......R", 'R' },
+    { PHASE_MIDGAME, "..RRBRR./..RRBB../..RRBB../......../..B...../B.....B./.....BBB/B......R", 'R' },
+    { PHASE_MIDGAME, "..RRRB../..RRR.../..BRBBBR/..B.BB../..B...../......B./.....RRR/B.....RR", 'R' },
+    { PHASE_MIDGAME, "R..B..BR/.RR..B../..RB.#../.BB.R.../...RR.B./..#.BB../.R....B./B..R...R", 'R' },
+    { PHASE_ENDGAME, ".RBBBRRR/.BBBBBBR/.RRRBBBB/.RRRBBBB/..RRRBBB/..RRRBBB/B.RRRRBB/..R...BB", 'B' },
+    { PHASE_ENDGAME, "RRBBBRRR/.BBBBBBR/.RBBBBBB/B.BBBBBB/.BBBBBRR/.BBBBBRR/R.RBBRRR/..BBBRRB", 'R' },
+};
+
+#define N_CORPUS ((int)(sizeof(CORPUS) / sizeof(CORPUS[0])))
+
+// 한 단계의 국면과 그 국면의 수
+typedef struct PhaseSet {
+    int      n;
+    Position pos[BENCH_MAX_POS];
+    int      side[BENCH_MAX_POS];
+    cJSON   *json[BENCH_MAX_POS];
+    MoveList moves[BENCH_MAX_POS];
+    int      n_moves[BENCH_MAX_POS];
+    int      total_moves;
+} PhaseSet;
+
+// 묶음 한 바퀴를 돌고 op 수를 돌려준다
+typedef uint64_t (*BenchFn)(PhaseSet *set);
+
+typedef struct BenchResult {
+    const char *name;
+    int         phase;
+    int         samples;
+    uint64_t    ops;        // 표본 하나의 op 수
+    double      mean;       // ns/op
+    double      stddev;
+    double      min;
+    double      max;
+} BenchResult;
+
+// 결과를 버리지 않게 모아 두는 곳
+static volatile uint64_t sink;
+
+static double generate_seconds;     // bench_generate가 잰 시간 (치환표 비우기 제외)
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s [-out FILE] [-samples N] [-ms N] [-only NAME] [엔진 옵션 (-depth N, -weights FILE, ...)]\n"
+            "Example:\n"
+            "  %s -out bench.json -samples 20 -ms 50 -depth 4\n",
+            progname, progname);
+}
+
+static uint64_t bench_gather(PhaseSet *set) {
+    uint64_t acc = 0;
+    MoveList moves;
+    for (int i = 0; i < set->n; i++) acc += gather_moves(&set->pos[i], set->side[i], &moves);
+    sink += acc;
+    return set->n;
+}
+
+static uint64_t bench_apply(PhaseSet *set) {
+    uint64_t acc = 0;
+    for (int i = 0; i < set->n; i++) {
+        for (int k = 0; k < set->n_moves[i]; k++) {
+            Position p = set->pos[i];
+            apply_move(&p, set->moves[i][k], set->side[i]);
+            acc += p.key;
+        }
+    }
+    sink += acc;
+    return set->total_moves;
+}
+
+static uint64_t bench_greedy_value(PhaseSet *set) {
+    uint64_t acc = 0;
+    for (int i = 0; i < set->n; i++) {
+        for (int k = 0; k < set->n_moves[i]; k++) acc += calc_greedy_value(&set->pos[i], set->moves[i][k], set->side[i]);
+    }
+    sink += acc;
+    return set->total_moves;
+}
+
+static uint64_t bench_safe_jump(PhaseSet *set) {
+    uint64_t acc = 0;
+    for (int i = 0; i < set->n; i++) {
+        for (int k = 0; k < set->n_moves[i]; k++) acc += is_safe_jump(&set->pos[i], set->moves[i][k], set->side[i]);
+    }
+    sink += acc;
+    return set->total_moves;
+}
+
+static uint64_t bench_five_greedy(PhaseSet *set) {
+    uint64_t acc = 0;
+    for (int i = 0; i < set->n; i++) {
+        for (int k = 0; k < set->n_moves[i]; k++) {
+            acc += evaluate_five_greedy(&set->pos[i], set->moves[i][k], set->side[i]);
+        }
+    }
+    sink += acc;
+    return set->total_moves;
+}
+
+static uint64_t bench_generate(PhaseSet *set) {
+    for (int i = 0; i < set->n; i++) {
+        int sx, sy, tx, ty;
+        tt_clear();
+        double start = now_sec();
+        generate_move(set->json[i], 0, &sx, &sy, &tx, &ty, set->side[i] ? 'B' : 'R');
+        generate_seconds += now_sec() - start;
+        sink += sx * 4096 + sy * 512 + tx * 64 + ty;
+    }
+    return set->n;
+}
+
+typedef struct BenchDef {
+    const char *name;
+    BenchFn     fn;
+    bool        self_timed;     // 함수가 잰 시간(generate_seconds)을 쓴다
+} BenchDef;
+
+static const BenchDef BENCHES[] = {
+    { "gather_moves",         bench_gather,       false },
+    { "apply_move",           bench_apply,        false },
+    { "calc_greedy_value",    bench_greedy_value, false },
+    { "is_safe_jump",         bench_safe_jump,    false },
+    { "evaluate_five_greedy", bench_five_greedy,  false },
+    { "generate_move",        bench_generate,     true },
+};
+
+#define N_BENCHES ((int)(sizeof(BENCHES) / sizeof(BENCHES[0])))
+
+// 한 바퀴의 시간 (초)
+static double run_once(const BenchDef *b, PhaseSet *set, int reps, uint64_t *ops) {
+    generate_seconds = 0;
+    *ops = 0;
+    double start = now_sec();
+    for (int r = 0; r < reps; r++) *ops += b->fn(set);
+    double sec = now_sec() - start;
+    return b->self_timed ? generate_seconds : sec;
+}
+
+static void run_bench(const BenchDef *b, PhaseSet *set, int phase, int samples, double target,
+                      BenchResult *res) {
+    // 반복 수 맞추기: 한 바퀴를 재고 표본 하나가 target초쯤 되도록
+    uint64_t ops;
+    double one = run_once(b, set, 1, &ops);
+    int reps = one > 0 ? (int)(target / one) : 1;
+    if (reps < 1) reps = 1;
+
+    double sum = 0, sum2 = 0, lo = INFINITY, hi = 0;
+    for (int s = 0; s < samples; s++) {
+        double ns = run_once(b, set, reps, &ops) * 1e9 / ops;
+        sum += ns;
+        sum2 += ns * ns;
+        if (ns < lo) lo = ns;
+        if (ns > hi) hi = ns;
+    }
+    res->name = b->name;
+    res->phase = phase;
+    res->samples = samples;
+    res->ops = ops;
+    res->mean = sum / samples;
+    double var = samples > 1 ? (sum2 - sum * sum / samples) / (samples - 1) : 0;
+    res->stddev = var > 0 ? sqrt(var) : 0;
+    res->min = lo;
+    res->max = hi;
+}
+
+static int write_json(const char *path, const BenchResult *res, int n) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *eng = cJSON_AddObjectToObject(root, "engine");
+    cJSON_AddStringToObject(eng, "mode", g_config.mode == ENGINE_GREEDY ? "greedy" : g_config.mode == ENGINE_MCTS ? "mcts" : "search");
+    cJSON_AddNumberToObject(eng, "depth", g_config.depth ? g_config.depth : DEFAULT_DEPTH);
+    cJSON_AddNumberToObject(eng, "threads", g_config.threads);
+    cJSON_AddNumberToObject(eng, "hash_mb", g_config.hash_mb);
+    cJSON_AddNumberToObject(eng, "endgame", g_config.endgame);
+    cJSON_AddStringToObject(eng, "weights", g_config.weights ? g_config.weights : "");
+    cJSON *arr = cJSON_AddArrayToObject(root, "results");
+    for (int i = 0; i < n; i++) {
+        cJSON *r = cJSON_CreateObject();
+        cJSON_AddStringToObject(r, "name", res[i].name);
+        cJSON_AddStringToObject(r, "phase", PHASE_NAMES[res[i].phase]);
+        cJSON_AddNumberToObject(r, "ns_per_op", res[i].mean);
+        cJSON_AddNumberToObject(r, "stddev", res[i].stddev);
+        cJSON_AddNumberToObject(r, "min", res[i].min);
+        cJSON_AddNumberToObject(r, "max", res[i].max);
+        cJSON_AddNumberToObject(r, "samples", res[i].samples);
+        cJSON_AddNumberToObject(r, "ops_per_sample", (double)res[i].ops);
+        cJSON_AddItemToArray(arr, r);
+    }
+    char *text = cJSON_Print(root);
+    cJSON_Delete(root);
+    FILE *fp = fopen(path, "w");
+    int ok = fp && text && fputs(text, fp) >= 0 && fputc('\n', fp) != EOF;
+    if (fp) ok &= fclose(fp) == 0;
+    free(text);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *out = "bench.json", *only = NULL;
+    int samples = 15, ms = 20;
+    g_config.endgame = 0;
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "-out") == 0)          out = argv[i + 1];
+        else if (strcmp(argv[i], "-samples") == 0) samples = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-ms") == 0)      ms = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-only") == 0)    only = argv[i + 1];
+        else if (!engine_parse_option(&g_config, argv[i], argv[i + 1])) {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (samples < 1 || ms < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!engine_init(&g_config)) {
+        fprintf(stderr, "엔진 초기화 실패 (치환표 %d MB, 가중치 %s)\n", g_config.hash_mb,
+                g_config.weights ? g_config.weights : "없음");
+        return 1;
+    }
+
+    static PhaseSet sets[N_PHASES];
+    for (int i = 0; i < N_CORPUS; i++) {
+        PhaseSet *set = &sets[CORPUS[i].phase];
+        int k = set->n++;
+        const char *rows[SIZE];
+        for (int r = 0; r < SIZE; r++) rows[r] = CORPUS[i].board + r * (SIZE + 1);
+        position_load(&set->pos[k], rows);
+        set->side[k] = side_index(CORPUS[i].side);
+        set->json[k] = cJSON_CreateArray();
+        for (int r = 0; r < SIZE; r++) {
+            char row[SIZE + 1];
+            memcpy(row, rows[r], SIZE);
+            row[SIZE] = '\0';
+            cJSON_AddItemToArray(set->json[k], cJSON_CreateString(row));
+        }
+        set->n_moves[k] = gather_moves(&set->pos[k], set->side[k], &set->moves[k]);
+        set->total_moves += set->n_moves[k];
+    }
+
+    BenchResult res[N_BENCHES * N_PHASES];
+    int n = 0;
+    printf("%-22s %-8s %12s %10s %12s\n", "bench", "phase", "ns/op", "stddev", "min");
+    for (int b = 0; b < N_BENCHES; b++) {
+        if (only && strcmp(only, BENCHES[b].name) != 0) continue;
+        for (int p = 0; p < N_PHASES; p++) {
+            run_bench(&BENCHES[b], &sets[p], p, samples, ms / 1000.0, &res[n]);
+            printf("%-22s %-8s %12.1f %10.1f %12.1f\n", res[n].name, PHASE_NAMES[p], res[n].mean, res[n].stddev,
+                   res[n].min);
+            fflush(stdout);
+            n++;
+        }
+    }
+    if (n == 0) {
+        fprintf(stderr, "벤치마크 없음: %s\n", only);
+        return 1;
+    }
+    if (!write_json(out, res, n)) {
+        perror("결과 파일 쓰기 실패");
+        return 1;
+    }
+    printf("[벤치] %s에 %d개 기록\n", out, n);
+    for (int p = 0; p < N_PHASES; p++) {
+        for (int i = 0; i < sets[p].n; i++) cJSON_Delete(sets[p].json[i]);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,200 @@
+// book.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "book.h"
+
+static const BookEntry *entries;
+static uint32_t         n_entries;
+static void            *map_base;
+static size_t           map_size;
+
+int book_open(const char *path) {
+    book_close();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(BookHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+
+    const BookHeader *h = (const BookHeader *)base;
+    if (memcmp(h->magic, BOOK_MAGIC, 8) != 0 ||
+        sizeof(BookHeader) + (size_t)h->count * sizeof(BookEntry) > (size_t)st.st_size) {
+        munmap(base, st.st_size);
+        return 0;
+    }
+    // 이분 탐색이라 미리 읽어 올 필요가 없다
+    madvise(base, st.st_size, MADV_RANDOM);
+
+    map_base = base;
+    map_size = st.st_size;
+    entries = (const BookEntry *)((const char *)base + sizeof(BookHeader));
+    n_entries = h->count;
+    return 1;
+}
+
+void book_close(void) {
+    if (map_base) munmap(map_base, map_size);
+    map_base = NULL;
+    entries = NULL;
+    n_entries = 0;
+}
+
+int book_probe(const Position *pos, int side, Move *mv, int *score) {
+    if (!entries) return 0;
+    uint64_t key = book_key(pos, side);
+    uint32_t lo = 0, hi = n_entries;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (entries[mid].key < key) lo = mid + 1;
+        else                        hi = mid;
+    }
+    if (lo == n_entries || entries[lo].key != key) return 0;
+
+    if (entries[lo].from >= SIZE * SIZE || entries[lo].to >= SIZE * SIZE) return 0;
+    Move m = move_pack(entries[lo].from, entries[lo].to);
+    if (!is_valid_move(pos, m, side)) return 0;
+    *mv = m;
+    *score = entries[lo].score;
+    return 1;
+}
+
+#ifdef BOOK_STANDALONE
+// 자체 대국으로 오프닝북 만들기
+// 대국마다 처음 -random 수는 무작위로 두어 갈래를 만들고, -plies 수까지 나온 국면마다
+// -depth 깊이로 탐색한 최선 수를 기록한다. 같은 국면은 한 번만 탐색한다
+#include "search.h"
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s -out <file> [-games N] [-plies N] [-depth N] [-random N] [-seed N]\n"
+            "          [-board R......B/......../...] [-hash MB]\n"
+            "Example:\n"
+            "  %s -out book.bin -games 200 -plies 8 -depth 9\n",
+            progname, progname);
+}
+
+static int cmp_entry(const void *a, const void *b) {
+    uint64_t x = ((const BookEntry *)a)->key, y = ((const BookEntry *)b)->key;
+    return x < y ? -1 : x > y;
+}
+
+// 정렬된 배열에서 key를 찾는다
+static BookEntry *find_entry(BookEntry *list, int n, uint64_t key) {
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (list[mid].key < key) lo = mid + 1;
+        else                     hi = mid;
+    }
+    return (lo < n && list[lo].key == key) ? &list[lo] : NULL;
+}
+
+int main(int argc, char *argv[]) {
+    const char *out = NULL;
+    const char *board = "R......B/......../......../......../......../......../......../B......R";
+    int games = 100, plies = 8, depth = 8, random_plies = 2;
+    unsigned seed = 1;
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "-out") == 0)         out = argv[i + 1];
+        else if (strcmp(argv[i], "-games") == 0)  games = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-plies") == 0)  plies = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-depth") == 0)  depth = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-random") == 0) random_plies = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-seed") == 0)   seed = (unsigned)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-board") == 0)  board = argv[i + 1];
+        else if (!engine_parse_option(&g_config, argv[i], argv[i + 1])) {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!out || games <= 0 || plies <= 0 || depth <= 0 || strlen(board) != SIZE * (SIZE + 1) - 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!engine_init(&g_config)) {
+        fprintf(stderr, "치환표 할당 실패 (%d MB)\n", g_config.hash_mb);
+        return 1;
+    }
+
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) rows[i] = board + i * (SIZE + 1);
+    Position start;
+    position_load(&start, rows);
+    srand(seed);
+
+    // 새 국면은 뒤에 붙이고, 대국이 끝날 때마다 정렬해서 찾기 쉽게 둔다
+    int cap = 1024, n = 0, sorted = 0;
+    BookEntry *list = (BookEntry *)malloc(cap * sizeof(BookEntry));
+    uint64_t searched = 0;
+
+    for (int g = 0; g < games; g++) {
+        Position pos = start;
+        int side = 0;
+        for (int ply = 0; ply < plies; ply++) {
+            MoveList moves;
+            int cnt = gather_moves(&pos, side, &moves);
+            if (cnt == 0) {
+                side ^= 1;
+                continue;
+            }
+            uint64_t key = book_key(&pos, side);
+            BookEntry *e = find_entry(list, sorted, key);
+            for (int i = sorted; !e && i < n; i++) {
+                if (list[i].key == key) e = &list[i];
+            }
+            if (!e) {
+                Move best;
+                memset(&g_stats, 0, sizeof(g_stats));
+                search_root(&pos, side, depth, 0, &best);
+                searched++;
+                if (n == cap) list = (BookEntry *)realloc(list, (cap *= 2) * sizeof(BookEntry));
+                e = &list[n++];
+                memset(e, 0, sizeof(*e));
+                e->key = key;
+                e->from = (uint8_t)move_from(best);
+                e->to = (uint8_t)move_to(best);
+                e->score = (int16_t)g_stats.score;
+                e->depth = (uint16_t)g_stats.depth;
+            }
+            Move mv = move_pack(e->from, e->to);
+            if (ply < random_plies) mv = moves[rand() % cnt];
+            apply_move(&pos, mv, side);
+            side ^= 1;
+        }
+        qsort(list, n, sizeof(BookEntry), cmp_entry);
+        sorted = n;
+        printf("[북] %d/%d 대국, 국면 %d개 (탐색 %llu번)\n", g + 1, games, n, (unsigned long long)searched);
+    }
+
+    FILE *fp = fopen(out, "wb");
+    if (!fp) {
+        perror("북 파일 열기 실패");
+        return 1;
+    }
+    BookHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, BOOK_MAGIC, 8);
+    h.count = n;
+    fwrite(&h, sizeof(h), 1, fp);
+    fwrite(list, sizeof(BookEntry), n, fp);
+    fclose(fp);
+    free(list);
+    printf("[북] %s: 국면 %d개, %zu바이트\n", out, n, sizeof(h) + n * sizeof(BookEntry));
+    return 0;
+}
+#endif
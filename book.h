@@ -0,0 +1,42 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stdint.h>
+#include "engine.h"
+
+// 오프닝북 파일 형식 (리틀 엔디언)
+// BookHeader 뒤에 BookEntry가 key 오름차순으로 count개
+// 파일을 mmap해서 이분 탐색하므로 읽은 페이지만 메모리에 올라온다
+#define BOOK_MAGIC "ATXBOOK1"
+
+typedef struct BookHeader {
+    char     magic[8];
+    uint32_t count;
+    uint32_t reserved;
+} BookHeader;
+
+typedef struct BookEntry {
+    uint64_t key;           // book_key
+    uint8_t  from;
+    uint8_t  to;
+    int16_t  score;         // 만들 때의 탐색 점수 (둘 차례 기준)
+    uint16_t depth;         // 만들 때의 탐색 깊이
+    uint16_t reserved;
+} BookEntry;
+
+static_assert(sizeof(BookHeader) == 16, "book header layout");
+static_assert(sizeof(BookEntry) == 16, "book entry layout");
+
+// 둘 차례와 '#' 칸 배치까지 포함한 키
+static inline uint64_t book_key(const Position *pos, int side) {
+    return position_hash(pos, side) ^ layout_hash(pos);
+}
+
+// 파일을 mmap으로 연다. 실패하면 0 (형식이 맞지 않는 경우 포함)
+int  book_open(const char *path);
+void book_close(void);
+
+// 열린 북에서 국면을 찾아 수를 돌려준다. 없거나 둘 수 없는 수면 0
+int  book_probe(const Position *pos, int side, Move *mv, int *score);
+
+#endif
@@ -8,14 +8,13 @@
 #include <netdb.h>
 #include "cjson/cJSON.h"
 #include "board.h"
+#include "engine.h"
 
 #define BUF_SIZE 4096
 
 // 전역 사용자명 버퍼
 char g_username[32];
 
-#define SIZE 8
-
 int map_char_int(char c)
 {
     switch (c)
@@ -40,622 +39,6 @@ void get_board(cJSON* board_array, int int_board[][10])
     }
 }
 
-// 2차원 배열로 보드 복사 (8×8 char)
-// JSON 배열을 받아서 board[8][8]에 저장
-// board_json은 길이 8인 문자열 배열: 각 문자열은 8글자(R, B, . 중 하나)
-static void parse_board(const cJSON *board_json, char board[SIZE][SIZE]) {
-    for (int i = 0; i < SIZE; i++) {
-        const cJSON *row = cJSON_GetArrayItem(board_json, i);
-        const char *str = row->valuestring;
-        for (int j = 0; j < SIZE; j++) {
-            board[i][j] = str[j];
-        }
-    }
-}
-// 8방향 델타
-
-static const int dr[8] = { -1, -1, -1,  0, 1, 1, 1,  0 };
-
-static const int dc[8] = { -1,  0,  1,  1, 1, 0, -1, -1 };
-
-
-
-// 보드 경계 검사
-
-static int boundary_check(int r, int c) {
-
-    return (r >= 0 && r < SIZE && c >= 0 && c < SIZE);
-
-}
-
-
-
-// board2에 board1 내용 복사
-
-static void copy_board(char dest[SIZE][SIZE], char src[SIZE][SIZE]) {
-
-    memcpy(dest, src, SIZE * SIZE * sizeof(char));
-
-}
-
-
-
-
-static void apply_move(char board[SIZE][SIZE], int r1, int c1, int r2, int c2, char player) {
-
-    int drc = abs(r2 - r1), dcc = abs(c2 - c1);
-
-    if (drc <= 1 && dcc <= 1) {
-
-
-        board[r2][c2] = player;
-
-    } else {
-
-
-        board[r1][c1] = '.';
-
-        board[r2][c2] = player;
-
-    }
-
-
-    char opp = (player == 'R') ? 'B' : 'R';
-
-    for (int f = 0; f < 8; f++) {
-
-        int nr = r2 + dr[f], nc = c2 + dc[f];
-
-        if (boundary_check(nr, nc) && board[nr][nc] == opp) {
-
-            board[nr][nc] = player;
-
-        }
-
-    }
-
-}
-
-
-
-
-static int count_pieces(char board[SIZE][SIZE], char player) {
-
-    int cnt = 0;
-
-    for (int i = 0; i < SIZE; i++)
-
-        for (int j = 0; j < SIZE; j++)
-
-            if (board[i][j] == player) cnt++;
-
-    return cnt;
-
-}
-
-
-
-
-static int is_valid_move(char board[SIZE][SIZE], int r1, int c1, int r2, int c2, char player) {
-
-    if (!boundary_check(r1, c1) || !boundary_check(r2, c2)) return 0;
-
-    if (board[r1][c1] != player) return 0;
-
-    if (board[r2][c2] != '.') return 0;
-
-    int drc = abs(r2 - r1), dcc = abs(c2 - c1);
-
-    int clone = (drc <= 1 && dcc <= 1 && !(drc == 0 && dcc == 0));
-
-    int jump  = ((drc == 2 && dcc == 0) || (drc == 0 && dcc == 2) || (drc == 2 && dcc == 2));
-
-    return (clone || jump);
-
-}
-
-
-
-
-static int gather_moves(char board[SIZE][SIZE], char player, int moves[][4]) {
-
-    int cnt = 0;
-
-    for (int r1 = 0; r1 < SIZE; r1++) {
-
-        for (int c1 = 0; c1 < SIZE; c1++) {
-
-            if (board[r1][c1] != player) continue;
-
-            for (int drd = -2; drd <= 2; drd++) {
-
-                for (int dcd = -2; dcd <= 2; dcd++) {
-
-                    int r2 = r1 + drd, c2 = c1 + dcd;
-
-                    if (is_valid_move(board, r1, c1, r2, c2, player)) {
-
-                        moves[cnt][0] = r1;
-
-                        moves[cnt][1] = c1;
-
-                        moves[cnt][2] = r2;
-
-                        moves[cnt][3] = c2;
-
-                        cnt++;
-
-                    }
-
-                }
-
-            }
-
-        }
-
-    }
-
-    return cnt;
-
-}
-
-
-
-
-static int calc_greedy_value(char board[SIZE][SIZE], int r1, int c1, int r2, int c2, char player) {
-
-    char sim[SIZE][SIZE];
-
-    copy_board(sim, board);
-
-    int before = count_pieces(sim, player);
-
-    apply_move(sim, r1, c1, r2, c2, player);
-
-    int after = count_pieces(sim, player);
-
-    return after - before;
-
-}
-
-
-
-static int is_safe_jump(char board[SIZE][SIZE], int r1, int c1, int r2, int c2, char player) {
-
-    int drc = abs(r2 - r1), dcc = abs(c2 - c1);
-
-    int jump = ((drc == 2 && dcc == 0) || (drc == 0 && dcc == 2) || (drc == 2 && dcc == 2));
-
-    if (!jump) return 0;
-
-    char sim[SIZE][SIZE];
-
-    copy_board(sim, board);
-
-    sim[r1][c1] = '.'; 
-
-    char opp = (player == 'R') ? 'B' : 'R';
-
-
-    for (int rr = 0; rr < SIZE; rr++) {
-
-        for (int cc = 0; cc < SIZE; cc++) {
-
-            if (sim[rr][cc] != opp) continue;
-
-            int drd = abs(r1 - rr), dcd = abs(c1 - cc);
-
-            if ((drd <= 1 && dcd <= 1 && !(drd == 0 && dcd == 0)) || 
-
-                ((drd == 2 && dcd == 0) || (drd == 0 && dcd == 2) || (drd == 2 && dcd == 2))) {
-
-                return 0;  
-
-            }
-
-        }
-
-    }
-
-    return 1;
-
-}
-
-
-
-// (r2,c2) 주변 8방향에 있는 내 말 개수 + 모서리/꼭짓점 보너스
-
-static int calc_friend_count(char board[SIZE][SIZE], int r2, int c2, char player) {
-
-    int cnt = 0;
-
-    for (int f = 0; f < 8; f++) {
-
-        int nr = r2 + dr[f], nc = c2 + dc[f];
-
-        if (boundary_check(nr, nc) && board[nr][nc] == player) {
-
-            cnt++;
-
-        }
-
-    }
-
-    int edge = (r2 == 0 || r2 == SIZE - 1) + (c2 == 0 || c2 == SIZE - 1);
-
-    if (edge == 2)      cnt += 3; 
-
-    else if (edge == 1) cnt += 1; 
-
-    return cnt;
-
-}
-
-
-
-
-extern bool move_generate_greedy_2n(char b[SIZE][SIZE], char player,
-
-                                    int *out_r1, int *out_c1,
-
-                                    int *out_r2, int *out_c2);
-
-
-
-
-static int evaluate_five_greedy(char board[SIZE][SIZE],
-
-                                int r1, int c1, int r2, int c2, char me) {
-
-    char opp = (me == 'R') ? 'B' : 'R';
-
-
-
-
-
-    int myGV1 = calc_greedy_value(board, r1, c1, r2, c2, me);
-
-
-
-
-    char board1[SIZE][SIZE];
-
-    copy_board(board1, board);
-
-    apply_move(board1, r1, c1, r2, c2, me);
-
-
-
-
-    int opp_moves1[SIZE*SIZE*8][4];
-
-    int opp_cnt1 = gather_moves(board1, opp, opp_moves1);
-
-    int bestOppGV1 = 0;
-
-    int or11 = -1, oc11 = -1, or12 = -1, oc12 = -1;
-
-    for (int i = 0; i < opp_cnt1; i++) {
-
-        int rr1 = opp_moves1[i][0], cc1 = opp_moves1[i][1];
-
-        int rr2 = opp_moves1[i][2], cc2 = opp_moves1[i][3];
-
-        int g = calc_greedy_value(board1, rr1, cc1, rr2, cc2, opp);
-
-        if (i == 0 || g > bestOppGV1) {
-
-            bestOppGV1 = g;
-
-            or11 = rr1;  oc11 = cc1;
-
-            or12 = rr2;  oc12 = cc2;
-
-        }
-
-    }
-
-
-    char board2[SIZE][SIZE];
-
-    if (opp_cnt1 > 0) {
-
-        copy_board(board2, board1);
-
-        apply_move(board2, or11, oc11, or12, oc12, opp);
-
-    } else {
-
-        copy_board(board2, board1);
-
-    }
-
-
-
-
-    int my_moves2[SIZE*SIZE*8][4];
-
-    int my_cnt2 = gather_moves(board2, me, my_moves2);
-
-    int bestMyGV2 = 0;
-
-    int mr21 = -1, mc21 = -1, mr22 = -1, mc22 = -1;
-
-    for (int i = 0; i < my_cnt2; i++) {
-
-        int rr1 = my_moves2[i][0], cc1 = my_moves2[i][1];
-
-        int rr2 = my_moves2[i][2], cc2 = my_moves2[i][3];
-
-        int g = calc_greedy_value(board2, rr1, cc1, rr2, cc2, me);
-
-        if (i == 0 || g > bestMyGV2) {
-
-            bestMyGV2 = g;
-
-            mr21 = rr1;  mc21 = cc1;
-
-            mr22 = rr2;  mc22 = cc2;
-
-        }
-
-    }
-
-
-    char board3[SIZE][SIZE];
-
-    if (my_cnt2 > 0) {
-
-        copy_board(board3, board2);
-
-        apply_move(board3, mr21, mc21, mr22, mc22, me);
-
-    } else {
-
-        copy_board(board3, board2);
-
-    }
-
-
-
-
-    int opp_moves2[SIZE*SIZE*8][4];
-
-    int opp_cnt2 = gather_moves(board3, opp, opp_moves2);
-
-    int bestOppGV2 = 0;
-
-    int or21 = -1, oc21 = -1, or22 = -1, oc22 = -1;
-
-    for (int i = 0; i < opp_cnt2; i++) {
-
-        int rr1 = opp_moves2[i][0], cc1 = opp_moves2[i][1];
-
-        int rr2 = opp_moves2[i][2], cc2 = opp_moves2[i][3];
-
-        int g = calc_greedy_value(board3, rr1, cc1, rr2, cc2, opp);
-
-        if (i == 0 || g > bestOppGV2) {
-
-            bestOppGV2 = g;
-
-            or21 = rr1;  oc21 = cc1;
-
-            or22 = rr2;  oc22 = cc2;
-
-        }
-
-    }
-
-
-    char board4[SIZE][SIZE];
-
-    if (opp_cnt2 > 0) {
-
-        copy_board(board4, board3);
-
-        apply_move(board4, or21, oc21, or22, oc22, opp);
-
-    } else {
-
-        copy_board(board4, board3);
-
-    }
-
-
-
-
-    int my_moves3[SIZE*SIZE*8][4];
-
-    int my_cnt3 = gather_moves(board4, me, my_moves3);
-
-    int bestMyGV3 = 0;
-
-    for (int i = 0; i < my_cnt3; i++) {
-
-        int rr1 = my_moves3[i][0], cc1 = my_moves3[i][1];
-
-        int rr2 = my_moves3[i][2], cc2 = my_moves3[i][3];
-
-        int g = calc_greedy_value(board4, rr1, cc1, rr2, cc2, me);
-
-        if (i == 0 || g > bestMyGV3) {
-
-            bestMyGV3 = g;
-
-        }
-
-    }
-
-
-
-    return (myGV1 - bestOppGV1 + bestMyGV2 - bestOppGV2 + bestMyGV3);
-
-}
-
-
-
-
-void generate_move(const cJSON *board_json, int *sx, int *sy, int *tx, int *ty, char me) {
-
-    char board[SIZE][SIZE];
-
-    parse_board(board_json, board);
-
-
-
-
-    int empty_cnt = 0;
-
-    for (int i = 0; i < SIZE; i++) {
-
-        for (int j = 0; j < SIZE; j++) {
-
-            if (board[i][j] == '.') empty_cnt++;
-
-        }
-
-    }
-
-    bool last_one = (empty_cnt == 1);
-
-
-
-
-    int moves[SIZE*SIZE*8][4];
-
-    int n_moves = gather_moves(board, me, moves);
-
-    if (n_moves == 0) {
-
-        *sx = *sy = *tx = *ty = 0;
-
-        return;
-
-    }
-
-
-
-    int bestEval   = -1000000;
-
-    int bestType   =  3;
-
-    int bestFriend = -1;
-
-    int bestR1=0, bestC1=0, bestR2=0, bestC2=0;
-
-
-
-    for (int i = 0; i < n_moves; i++) {
-
-        int r1 = moves[i][0], c1 = moves[i][1];
-
-        int r2 = moves[i][2], c2 = moves[i][3];
-
-
-
-        int drc = abs(r2 - r1), dcc = abs(c2 - c1);
-
-        bool is_jump = (drc == 2 || dcc == 2);
-
-
-
-
-        if (last_one && is_jump) continue;
-
-
-
-        int eval = evaluate_five_greedy(board, r1, c1, r2, c2, me);
-
-
-
-        bool safe = is_safe_jump(board, r1, c1, r2, c2, me);
-
-        int type;
-
-        if (is_jump && safe) type = 0;
-
-        else if (!is_jump)   type = 1;
-
-        else                 type = 2;
-
-
-
-        char sim[SIZE][SIZE];
-
-        copy_board(sim, board);
-
-        apply_move(sim, r1, c1, r2, c2, me);
-
-        int friendCnt = calc_friend_count(sim, r2, c2, me);
-
-
-
-        bool better = false;
-
-        if (eval > bestEval) {
-
-            better = true;
-
-        } else if (eval == bestEval) {
-
-            if (type < bestType) {
-
-                better = true;
-
-            } else if (type == bestType) {
-
-                if (friendCnt > bestFriend) {
-
-                    better = true;
-
-                } else if (friendCnt == bestFriend) {
-
-                    if (r2 < bestR2 || (r2 == bestR2 && c2 < bestC2)) {
-
-                        better = true;
-
-                    }
-
-                }
-
-            }
-
-        }
-
-
-
-        if (better) {
-
-            bestEval   = eval;
-
-            bestType   = type;
-
-            bestFriend = friendCnt;
-
-            bestR1 = r1; bestC1 = c1;
-
-            bestR2 = r2; bestC2 = c2;
-
-        }
-
-    }
-
-
-
-    *sx = bestR1 + 1;
-
-    *sy = bestC1 + 1;
-
-    *tx = bestR2 + 1;
-
-    *ty = bestC2 + 1;
-
-}
-
-
-
-
 static char *recv_json(int fd) {
     char buffer[BUF_SIZE];
     int idx = 0;
@@ -695,6 +78,9 @@ static int send_json(int fd, cJSON *obj) {
 static void print_usage(const char *progname) {
     fprintf(stderr,
             "Usage: %s -ip <server_ip> -port <server_port> -username <your_username>\n"
+            "          [-engine greedy|search|mcts] [-depth N] [-hash MB] [-aspiration N]\n"
+            "          [-threads N] [-smp lazy|ybwc] [-ponder on|off] [-book FILE] [-endgame N]\n"
+            "          [-weights FILE]\n"
             "Example:\n"
             "  %s -ip 10.8.128.233 -port 8080 -username Moonyoung\n",
             progname, progname);
@@ -724,8 +110,9 @@ int main(int argc, char *argv[]) {
     int board[10][10];
     float N, r1_, c1_, r2_, c2_, temp;
     int pass_flag=0;
+    int moved = 0;      // 수를 보내고 move_ok를 아직 받지 않음
 
-    if (argc != 7) {
+    if (argc < 7 || argc % 2 != 1) {
         print_usage(argv[0]);
         return 1;
     }
@@ -746,7 +133,7 @@ int main(int argc, char *argv[]) {
         else if (strcmp(argv[i], "-username") == 0) {
             strncpy(username, argv[i + 1], sizeof(username) - 1);
         }
-        else {
+        else if (!engine_parse_option(&g_config, argv[i], argv[i + 1])) {
             print_usage(argv[0]);
             return 1;
         }
@@ -757,6 +144,12 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    if (!engine_init(&g_config)) {
+        fprintf(stderr, "엔진 초기화 실패 (치환표 %d MB, 오프닝북 %s, 가중치 %s)\n", g_config.hash_mb,
+                g_config.book ? g_config.book : "없음", g_config.weights ? g_config.weights : "없음");
+        return 1;
+    }
+
     strncpy(g_username, username, sizeof(g_username) - 1);
     g_username[sizeof(g_username) - 1] = '\0';
 
@@ -838,7 +231,7 @@ int main(int argc, char *argv[]) {
             if (cJSON_IsArray(board_json) && cJSON_IsNumber(timeout)) {
                 int sx = 0, sy = 0, tx = 0, ty = 0;
 
-                generate_move(board_json, &sx, &sy, &tx, &ty, me);
+                generate_move(board_json, timeout->valuedouble, &sx, &sy, &tx, &ty, me);
 
                 cJSON *mv = cJSON_CreateObject();
                 cJSON_AddStringToObject(mv, "type", "move");
@@ -849,13 +242,79 @@ int main(int argc, char *argv[]) {
                 cJSON_AddNumberToObject(mv, "ty", ty);
                 send_json(sockfd, mv);
                 cJSON_Delete(mv);
+                moved = 1;
                 printf("[클라이언트] move 전송: (%d,%d) -> (%d,%d)\n", sx, sy, tx, ty);
+                uint64_t total = g_stats.gen_moves + g_stats.clone_dups;
+                if (g_stats.book_hit) printf("[엔진] 오프닝북 수 (점수 %d)\n", g_stats.score);
+                if (g_stats.playouts > 0)
+                    printf("[엔진] MCTS: 플레이아웃 %llu (%.0f/초), 트리 노드 %u, 깊이 %d, 승률 %.1f%%\n",
+                           (unsigned long long)g_stats.playouts,
+                           g_stats.seconds > 0 ? g_stats.playouts / g_stats.seconds : 0.0, g_stats.mcts_nodes,
+                           g_stats.mcts_depth, 100.0 * g_stats.win_rate);
+                if (g_stats.endgame > 0)
+                    printf("[엔진] 종반 솔버: 최종 말 차이 %d (증명됨, 수순 %d수, 노드 %llu)\n", g_stats.endgame_score,
+                           g_stats.depth, (unsigned long long)g_stats.nodes);
+                else if (g_stats.endgame == 0)
+                    printf("[엔진] 종반 솔버: 증명 못 함, 탐색으로 둠\n");
+                printf("[엔진] 깊이 %d, 점수 %d, 노드 %llu (%d스레드, %.0f nps), 치환표 적중 %llu/%llu\n",
+                       g_stats.depth, g_stats.score, (unsigned long long)g_stats.nodes,
+                       g_stats.threads, g_stats.seconds > 0 ? g_stats.nodes / g_stats.seconds : 0.0,
+                       (unsigned long long)g_stats.tt_hits, (unsigned long long)g_stats.tt_probes);
+                printf("[엔진] beta 컷 %llu (첫 수 %.1f%%, 치환표 수 %llu, 킬러 %llu)\n",
+                       (unsigned long long)g_stats.cutoffs,
+                       g_stats.cutoffs ? 100.0 * g_stats.cut_first / g_stats.cutoffs : 0.0,
+                       (unsigned long long)g_stats.cut_hash, (unsigned long long)g_stats.cut_killer);
+                printf("[엔진] 깊이별 노드:");
+                for (int d = 0; d < g_stats.depth; d++) {
+                    printf(" %d:%llu", d + 1, (unsigned long long)g_stats.iter_nodes[d]);
+                }
+                printf("\n");
+                printf("[엔진] PV:");
+                for (int k = 0; k < g_stats.pv_len; k++) {
+                    Move pm = g_stats.pv[k];
+                    if (pm == MOVE_NONE) printf(" pass");
+                    else printf(" (%d,%d)->(%d,%d)", move_from(pm) / SIZE + 1, move_from(pm) % SIZE + 1,
+                                move_to(pm) / SIZE + 1, move_to(pm) % SIZE + 1);
+                }
+                printf("\n");
+                printf("[엔진] aspiration fail high %llu, fail low %llu, PVS 재탐색 %llu\n",
+                       (unsigned long long)g_stats.asp_fail_high,
+                       (unsigned long long)g_stats.asp_fail_low,
+                       (unsigned long long)g_stats.pvs_researches);
+                if (g_config.smp == SMP_YBWC) {
+                    for (int k = 0; k < g_stats.threads; k++) {
+                        printf("[엔진] 스레드 %d: 분기 %llu, 훔침 %llu, 대기 %.3f초\n", k,
+                               (unsigned long long)g_stats.thread_splits[k],
+                               (unsigned long long)g_stats.thread_steals[k], g_stats.thread_idle[k]);
+                    }
+                }
+                if (g_stats.predict >= 0) {
+                    printf("[엔진] 상대 응수 예측 %s", g_stats.predict ? "적중" : "빗나감");
+                    if (!g_stats.predict) printf(" (%d칸 다름)", g_stats.predict_diff);
+                    Move rm = g_stats.reply;
+                    if (rm != MOVE_NONE)
+                        printf(", 실제 응수 (%d,%d)->(%d,%d)", move_from(rm) / SIZE + 1, move_from(rm) % SIZE + 1,
+                               move_to(rm) / SIZE + 1, move_to(rm) % SIZE + 1);
+                    printf(", 이어받은 깊이 %d\n", g_stats.reuse_depth);
+                }
+                if (g_stats.ponder_depth > 0) {
+                    printf("[엔진] 상대 차례 탐색: 깊이 %d, 노드 %llu, ", g_stats.ponder_depth,
+                           (unsigned long long)g_stats.ponder_nodes);
+                    if (g_stats.ponder_hit >= 0) printf("받은 국면 적중 (치환표 깊이 %d)\n", g_stats.ponder_hit);
+                    else printf("받은 국면 없음\n");
+                }
+                printf("[엔진] 생성 %llu수, 중복 복제 %llu수 제거 (%.1f%%)\n",
+                       (unsigned long long)g_stats.gen_moves,
+                       (unsigned long long)g_stats.clone_dups,
+                       total ? 100.0 * g_stats.clone_dups / total : 0.0);
             }
         }
 
         else if (strcmp(type->valuestring, "move_ok") == 0) {
             printf("[서버] move_ok 수신\n");
             cJSON *board_arr = cJSON_GetObjectItem(root, "board");
+            if (moved && cJSON_IsArray(board_arr)) engine_ponder_start(board_arr, me);
+            moved = 0;
             if (cJSON_IsArray(board_arr)) {
                 printf("----- 현재 보드 상태 (move_ok) -----\n");
                 int rows = cJSON_GetArraySize(board_arr);
@@ -883,6 +342,7 @@ int main(int argc, char *argv[]) {
 
         else if (strcmp(type->valuestring, "game_over") == 0) {
             printf("[서버] game_over 수신\n");
+            engine_ponder_stop();
 
             cJSON *board_arr = cJSON_GetObjectItem(root, "board");
             if (cJSON_IsArray(board_arr)) {
@@ -0,0 +1,175 @@
+// endgame.c
+#include <string.h>
+#include <time.h>
+#include "endgame.h"
+#include "search.h"
+#include "gain.h"
+
+// 종반 전용 치환표: 최종 점수의 하한/상한과 그 값을 얻은 남은 수순 길이를 저장
+// (증명된 값은 EG_PROVEN)
+#define EG_TT_BITS 20
+#define EG_PROVEN  0xff
+
+typedef struct EgEntry {
+    uint64_t key;
+    int8_t   lower;
+    int8_t   upper;
+    uint8_t  depth;
+    Move     move;          // 최선 수가 없으면 MOVE_NONE
+} EgEntry;
+
+static EgEntry eg_tt[1 << EG_TT_BITS];
+
+// 최종 점수 범위 (말 차이는 -64..64)
+#define EG_INF 127
+
+static double eg_start, eg_hard;
+static bool   eg_stop;
+
+// 표는 게임과 게임 사이에도 남으므로 '#' 칸 배치를 키에 섞는다 (탐색 중에는 바뀌지 않으므로 한 번만 구한다)
+static uint64_t eg_layout;
+
+static double eg_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline int eg_final(const Position *pos, int side) {
+    return pos->count[side] - pos->count[side ^ 1];
+}
+
+// 이득 순 정렬: 치환표 수 > 이득 (뒤집는 말 + 복제 1) > 복제
+static int eg_order(Move mv, const uint8_t *caps, Move hash_move) {
+    if (mv == hash_move) return 1 << 20;
+    int clone = !move_is_jump(mv);
+    return ((caps[move_to(mv)] + clone) << 4) | (clone << 3);
+}
+
+// depth = 남은 수순 길이. *proven은 돌려준 값(범위)이 한도와 상관없는 게임 값이면 true
+static int eg_search(Position *pos, int side, int depth, int alpha, int beta, bool *proven, Move *best_out) {
+    g_stats.nodes++;
+    if ((g_stats.nodes & 4095) == 0 && eg_now() - eg_start >= eg_hard) eg_stop = true;
+    *proven = true;
+    if (eg_stop) return 0;
+
+    if (pos->empty == 0 || pos->count[side] == 0 || pos->count[side ^ 1] == 0) return eg_final(pos, side);
+    if (depth == 0) {
+        *proven = false;
+        return eg_final(pos, side);
+    }
+
+    uint64_t key = position_hash(pos, side) ^ eg_layout;
+    EgEntry *e = &eg_tt[key & ((1 << EG_TT_BITS) - 1)];
+    Move hash_move = MOVE_NONE;
+    if (e->key == key) {
+        if (e->depth == EG_PROVEN || e->depth >= depth) {
+            *proven = e->depth == EG_PROVEN;
+            if (e->lower >= beta) return e->lower;
+            if (e->upper <= alpha) return e->upper;
+            if (e->lower == e->upper) return e->lower;
+        }
+        hash_move = e->move;
+    }
+
+    MoveList moves;
+    int n = gather_moves(pos, side, &moves);
+    if (n == 0) {
+        // 패스: 상대도 둘 수 없으면 게임 종료
+        MoveList opp;
+        *proven = true;
+        if (gather_moves(pos, side ^ 1, &opp) == 0) return eg_final(pos, side);
+        return -eg_search(pos, side ^ 1, depth - 1, -beta, -alpha, proven, NULL);
+    }
+
+    int keys[MAX_MOVES];
+    alignas(64) uint8_t caps[SIZE * SIZE];
+    ring1_counts(pos->bb[side ^ 1], caps);
+    for (int i = 0; i < n; i++) keys[i] = eg_order(moves[i], caps, hash_move);
+
+    int alpha_orig = alpha;
+    int best = -EG_INF;
+    bool all_proven = true;
+    Move best_move = MOVE_NONE;
+    for (int i = 0; i < n; i++) {
+        int bi = i;
+        for (int j = i + 1; j < n; j++) {
+            if (keys[j] > keys[bi]) bi = j;
+        }
+        Move mv = moves[bi];
+        moves[bi] = moves[i];
+        moves[i] = mv;
+        int k = keys[bi];
+        keys[bi] = keys[i];
+        keys[i] = k;
+
+        Undo u;
+        bool p;
+        make_move(pos, mv, side, &u);
+        int score;
+        if (i == 0) {
+            score = -eg_search(pos, side ^ 1, depth - 1, -beta, -alpha, &p, NULL);
+        } else {
+            score = -eg_search(pos, side ^ 1, depth - 1, -alpha - 1, -alpha, &p, NULL);
+            if (score > alpha && score < beta && !eg_stop)
+                score = -eg_search(pos, side ^ 1, depth - 1, -beta, -alpha, &p, NULL);
+        }
+        unmake_move(pos, mv, side, &u);
+        if (eg_stop) return 0;
+        all_proven = all_proven && p;
+
+        if (score > best) {
+            best = score;
+            best_move = mv;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    // 증명된 수 하나로 난 컷이면 하한도 증명된 값
+                    all_proven = p;
+                    break;
+                }
+            }
+        }
+    }
+
+    *proven = all_proven;
+    // 증명된 값은 한도가 더 짧은 결과로 덮지 않는다
+    if (e->key != key || e->depth != EG_PROVEN || all_proven) {
+        e->key = key;
+        e->lower = best > alpha_orig ? best : -EG_INF;
+        e->upper = best < beta ? best : EG_INF;
+        e->depth = all_proven ? EG_PROVEN : depth;
+        e->move = best_move;
+    }
+    if (best_out) *best_out = best_move;
+    return best;
+}
+
+int endgame_solve(Position *pos, int side, double timeout, Move *best, int *score, int *exact) {
+    eg_start = eg_now();
+    eg_stop = false;
+    eg_layout = layout_hash(pos);
+    // 일반 탐색과 같은 시간 배분: soft가 지나면 새 한도를 시작하지 않는다
+    double hard = 1e9, soft = 1e9;
+    if (timeout > 0) {
+        hard = timeout - TIME_MARGIN;
+        if (hard < TIME_MIN) hard = TIME_MIN;
+        soft = hard * 0.5;
+    }
+    eg_hard = hard;
+
+    int solved = 0;
+    for (int depth = 1; depth <= ENDGAME_MAX_PLY; depth++) {
+        Move mv = MOVE_NONE;
+        bool proven;
+        int s = eg_search(pos, side, depth, -EG_INF, EG_INF, &proven, &mv);
+        if (eg_stop || mv == MOVE_NONE) break;
+        *best = mv;
+        *score = s;
+        *exact = proven;
+        g_stats.depth = depth;
+        solved = 1;
+        if (proven || eg_now() - eg_start >= soft) break;
+    }
+    return solved;
+}
@@ -0,0 +1,19 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "engine.h"
+
+// 빈칸이 -endgame N 이하인 국면을 게임 끝까지 읽는 종반 솔버
+// 점수는 최종 말 차이 (side 기준, 탐색 점수의 SCORE_WIN은 붙이지 않는다)
+//
+// 복제는 빈칸을 하나씩 채우지만 점프는 빈칸 수를 바꾸지 않아 수순의 길이에 끝이 없다
+// 그래서 수순 길이 한도를 1씩 늘려 가며 탐색하고, 한도에 걸린 말단 없이 모든 수순이
+// 게임 끝에 닿은 결과만 "증명됨"으로 표시한다. 증명된 값은 치환표에 한도 없이 남아
+// 다음 반복과 다음 턴에서 다시 탐색하지 않는다
+#define ENDGAME_MAX_PLY 60
+
+// timeout은 서버 timeout(초), 0 이하이면 시간 제한 없이 증명되거나 ENDGAME_MAX_PLY까지
+// *exact는 루트 값이 증명됐으면 1. 한도 1조차 끝내지 못하면 0을 돌려준다
+int endgame_solve(Position *pos, int side, double timeout, Move *best, int *score, int *exact);
+
+#endif
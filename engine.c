@@ -0,0 +1,540 @@
+// engine.c
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "engine.h"
+#include "search.h"
+#include "tt.h"
+#include "pool.h"
+#include "book.h"
+#include "endgame.h"
+#include "pattern.h"
+#include "gain.h"
+#include "mcts.h"
+
+thread_local EngineStats g_stats;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+EngineConfig g_config = { ENGINE_SEARCH, 0, 64, 2, 1, SMP_LAZY, 0, NULL, DEFAULT_ENDGAME, NULL };
+
+void position_load(Position *pos, const char *const rows[SIZE]) {
+    memset(pos, 0, sizeof(*pos));
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            uint64_t bit = 1ULL << (i * SIZE + j);
+            switch (rows[i][j]) {
+            case 'R': pos->bb[0] |= bit; break;
+            case 'B': pos->bb[1] |= bit; break;
+            case '.': pos->empty |= bit; break;
+            }
+        }
+    }
+    pos->count[0] = popcount64(pos->bb[0]);
+    pos->count[1] = popcount64(pos->bb[1]);
+    for (int s = 0; s < 2; s++) {
+        uint64_t b = pos->bb[s];
+        while (b) {
+            int sq = pop_lsb(&b);
+            pos->key ^= ZOBRIST.piece[s][sq];
+            pattern_update(pos->pat, sq, s + 1);
+        }
+    }
+}
+
+// JSON 배열을 받아서 비트보드로 변환
+// board_json은 길이 8인 문자열 배열: 각 문자열은 8글자(R, B, ., # 중 하나)
+static void parse_board(const cJSON *board_json, Position *pos) {
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+        rows[i] = cJSON_GetArrayItem(board_json, i)->valuestring;
+    }
+    position_load(pos, rows);
+}
+
+void apply_move(Position *pos, Move mv, int side) {
+    Undo u;
+    make_move(pos, mv, side, &u);
+}
+
+int count_pieces(const Position *pos, int side) {
+    return pos->count[side];
+}
+
+int is_valid_move(const Position *pos, Move mv, int side) {
+    int from = move_from(mv), to = move_to(mv);
+    if (mv != move_pack(from, to)) return 0;     // MOVE_NONE이나 점프 비트가 맞지 않는 수
+    if (!(pos->bb[side] & (1ULL << from))) return 0;
+    if (!(pos->empty & (1ULL << to))) return 0;
+    return (SQ.reach[from] >> to) & 1;
+}
+
+// 출발 칸 기준 행 우선 순서로, 도착 칸도 행 우선 순서로 생성
+// 복제는 도착 칸마다 한 번만 (가장 앞선 출발 칸), 점프는 출발 칸마다 생성
+int gather_moves(const Position *pos, int side, MoveList *moves) {
+    int cnt = 0;
+    uint64_t pieces = pos->bb[side];
+    uint64_t cloned = 0;
+    while (pieces) {
+        int from = pop_lsb(&pieces);
+        uint64_t clones = SQ.ring1[from] & pos->empty;
+        uint64_t jumps = SQ.ring2[from] & pos->empty;
+        uint64_t targets = (clones & ~cloned) | jumps;
+        g_stats.clone_dups += popcount64(clones & cloned);
+        cloned |= clones;
+        // 복제와 점프 칸은 겹치지 않으므로 도착 칸 순서대로 뽑으면서 점프 비트만 붙인다
+        while (targets) {
+            int to = pop_lsb(&targets);
+            moves->m[cnt++] = (Move)(from | to << 6 | (int)((jumps >> to) & 1) << 12);
+        }
+    }
+    moves->n = cnt;
+    g_stats.gen_calls++;
+    g_stats.gen_moves += cnt;
+    return cnt;
+}
+
+// 수를 둔 뒤 늘어나는 내 말 개수: 복제 1 + 뒤집힌 말
+int calc_greedy_value(const Position *pos, Move mv, int side) {
+    return popcount64(SQ.ring1[move_to(mv)] & pos->bb[side ^ 1]) + !move_is_jump(mv);
+}
+
+// 출발 칸 주변 2칸 안에 상대 말이 없는 점프
+int is_safe_jump(const Position *pos, Move mv, int side) {
+    if (!move_is_jump(mv)) return 0;
+    return (SQ.reach[move_from(mv)] & pos->bb[side ^ 1]) == 0;
+}
+
+// to 주변 8방향에 있는 내 말 개수 + 모서리/꼭짓점 보너스
+int calc_friend_count(const Position *pos, int to, int side) {
+    return popcount64(SQ.ring1[to] & pos->bb[side]) + SQ.edge_bonus[to];
+}
+
+// side가 그리디 최선의 수를 둔다 (첫 번째 최댓값 우선). 둘 수 없으면 그대로
+// 둔 수는 *played에 남긴다 (없으면 MOVE_NONE)
+static int play_greedy(Position *pos, int side, Move *played, Undo *u) {
+    MoveList moves;
+    int cnt = gather_moves(pos, side, &moves);
+    // 도착 칸별 뒤집히는 말 수를 한 번에 (calc_greedy_value = caps[to] + 복제)
+    alignas(64) uint8_t caps[SIZE * SIZE];
+    ring1_counts(pos->bb[side ^ 1], caps);
+    int best = 0, bi = -1;
+    for (int i = 0; i < cnt; i++) {
+        int g = caps[move_to(moves[i])] + !move_is_jump(moves[i]);
+        if (i == 0 || g > best) {
+            best = g;
+            bi = i;
+        }
+    }
+    *played = MOVE_NONE;
+    if (bi >= 0) {
+        *played = moves[bi];
+        make_move(pos, *played, side, u);
+    }
+    return best;
+}
+
+static void unplay_greedy(Position *pos, Move played, int side, const Undo *u) {
+    if (played != MOVE_NONE) unmake_move(pos, played, side, u);
+}
+
+// mv를 둔 뒤 양쪽이 그리디로 2수씩 더 둔다고 가정한 5수 평가
+// pos 위에서 직접 두고 되돌리므로 호출이 끝나면 pos는 원래대로
+int evaluate_five_greedy(Position *pos, Move mv, int me) {
+    int opp = me ^ 1;
+    int myGV1 = calc_greedy_value(pos, mv, me);
+
+    Move m[3];
+    Undo u[4];
+    make_move(pos, mv, me, &u[3]);
+
+    int bestOppGV1 = play_greedy(pos, opp, &m[0], &u[0]);
+    int bestMyGV2  = play_greedy(pos, me,  &m[1], &u[1]);
+    int bestOppGV2 = play_greedy(pos, opp, &m[2], &u[2]);
+
+    MoveList moves;
+    int cnt = gather_moves(pos, me, &moves);
+    alignas(64) uint8_t caps[SIZE * SIZE];
+    ring1_counts(pos->bb[opp], caps);
+    int bestMyGV3 = 0;
+    for (int i = 0; i < cnt; i++) {
+        int g = caps[move_to(moves[i])] + !move_is_jump(moves[i]);
+        if (i == 0 || g > bestMyGV3) bestMyGV3 = g;
+    }
+
+    unplay_greedy(pos, m[2], opp, &u[2]);
+    unplay_greedy(pos, m[1], me,  &u[1]);
+    unplay_greedy(pos, m[0], opp, &u[0]);
+    unmake_move(pos, mv, me, &u[3]);
+
+    return (myGV1 - bestOppGV1 + bestMyGV2 - bestOppGV2 + bestMyGV3);
+}
+
+// 0 = 안전한 점프, 1 = 복제, 2 = 위험한 점프 (작을수록 선호)
+int move_type(const Position *pos, Move mv, int side) {
+    if (!move_is_jump(mv)) return 1;
+    return is_safe_jump(pos, mv, side) ? 0 : 2;
+}
+
+// 후보 하나의 평가 결과 (스레드 풀에서 후보마다 따로 계산)
+typedef struct GreedyScore {
+    bool     skip;
+    int      eval;
+    int      type;
+    int      friendCnt;
+    uint64_t gen_calls;         // 평가하는 동안 쌓인 생성 통계
+    uint64_t gen_moves;
+    uint64_t clone_dups;
+} GreedyScore;
+
+typedef struct GreedyJob {
+    const Position *pos;
+    int             side;
+    bool            last_one;
+    const Move     *moves;
+    GreedyScore    *out;
+} GreedyJob;
+
+static void greedy_task(int i, void *arg) {
+    const GreedyJob *job = (const GreedyJob *)arg;
+    Move mv = job->moves[i];
+    GreedyScore *s = &job->out[i];
+    s->skip = job->last_one && move_is_jump(mv);
+    if (s->skip) return;
+
+    // 스레드마다 국면을 따로 두고 직접 두었다가 되돌린다
+    Position pos = *job->pos;
+    EngineStats before = g_stats;
+    s->eval = evaluate_five_greedy(&pos, mv, job->side);
+    s->type = move_type(&pos, mv, job->side);
+
+    Undo u;
+    make_move(&pos, mv, job->side, &u);
+    s->friendCnt = calc_friend_count(&pos, move_to(mv), job->side);
+    unmake_move(&pos, mv, job->side, &u);
+
+    s->gen_calls  = g_stats.gen_calls  - before.gen_calls;
+    s->gen_moves  = g_stats.gen_moves  - before.gen_moves;
+    s->clone_dups = g_stats.clone_dups - before.clone_dups;
+}
+
+// 후보마다 5수 그리디 평가 후 type / friendCnt / (r2,c2) 순으로 동점 처리
+// 평가는 스레드 풀에서 나눠 하고, 고르는 것은 생성 순서대로 한 스레드에서 하므로
+// 스레드 수와 상관없이 결과가 같다
+int choose_greedy(Position *pos, int side, Move *out) {
+    bool last_one = (popcount64(pos->empty) == 1);
+
+    MoveList moves;
+    int n_moves = gather_moves(pos, side, &moves);
+    if (n_moves == 0) return 0;
+
+    GreedyScore scores[MAX_MOVES];
+    GreedyJob job = { pos, side, last_one, moves.m, scores };
+    pool_for(n_moves, greedy_task, &job);
+
+    int bestEval   = -1000000;
+    int bestType   =  3;
+    int bestFriend = -1;
+    Move best = 0;
+
+    for (int i = 0; i < n_moves; i++) {
+        Move mv = moves[i];
+        const GreedyScore *s = &scores[i];
+        if (s->skip) continue;
+
+        g_stats.gen_calls  += s->gen_calls;
+        g_stats.gen_moves  += s->gen_moves;
+        g_stats.clone_dups += s->clone_dups;
+
+        int eval = s->eval;
+        int type = s->type;
+        int friendCnt = s->friendCnt;
+
+        bool better = false;
+        if (eval > bestEval) {
+            better = true;
+        } else if (eval == bestEval) {
+            if (type < bestType) {
+                better = true;
+            } else if (type == bestType) {
+                if (friendCnt > bestFriend) {
+                    better = true;
+                } else if (friendCnt == bestFriend) {
+                    if (move_to(mv) < move_to(best)) better = true;
+                }
+            }
+        }
+
+        if (better) {
+            bestEval   = eval;
+            bestType   = type;
+            bestFriend = friendCnt;
+            best       = mv;
+        }
+    }
+
+    *out = best;
+    return 1;
+}
+
+int engine_parse_option(EngineConfig *cfg, const char *flag, const char *value) {
+    if (strcmp(flag, "-engine") == 0) {
+        if (strcmp(value, "greedy") == 0)      cfg->mode = ENGINE_GREEDY;
+        else if (strcmp(value, "search") == 0) cfg->mode = ENGINE_SEARCH;
+        else if (strcmp(value, "mcts") == 0)   cfg->mode = ENGINE_MCTS;
+        else return 0;
+        return 1;
+    }
+    if (strcmp(flag, "-hash") == 0) {
+        cfg->hash_mb = atoi(value);
+        return cfg->hash_mb > 0;
+    }
+    if (strcmp(flag, "-aspiration") == 0) {
+        cfg->aspiration = atoi(value);
+        return cfg->aspiration >= 0;
+    }
+    if (strcmp(flag, "-threads") == 0) {
+        cfg->threads = atoi(value);
+        return cfg->threads >= 1 && cfg->threads <= MAX_THREADS;
+    }
+    if (strcmp(flag, "-smp") == 0) {
+        if (strcmp(value, "lazy") == 0)      cfg->smp = SMP_LAZY;
+        else if (strcmp(value, "ybwc") == 0) cfg->smp = SMP_YBWC;
+        else return 0;
+        return 1;
+    }
+    if (strcmp(flag, "-ponder") == 0) {
+        if (strcmp(value, "on") == 0)       cfg->ponder = 1;
+        else if (strcmp(value, "off") == 0) cfg->ponder = 0;
+        else return 0;
+        return 1;
+    }
+    if (strcmp(flag, "-book") == 0) {
+        cfg->book = value;
+        return 1;
+    }
+    if (strcmp(flag, "-weights") == 0) {
+        cfg->weights = value;
+        return 1;
+    }
+    if (strcmp(flag, "-endgame") == 0) {
+        cfg->endgame = atoi(value);
+        return cfg->endgame >= 0 && cfg->endgame < SIZE * SIZE;
+    }
+    if (strcmp(flag, "-depth") == 0) {
+        cfg->depth = atoi(value);
+        return cfg->depth >= 0;
+    }
+    return 0;
+}
+
+int engine_init(const EngineConfig *cfg) {
+    if (cfg->mode == ENGINE_GREEDY && !pool_init(cfg->threads)) return 0;
+    if (cfg->mode == ENGINE_MCTS && !mcts_init()) return 0;
+    if (cfg->book && !book_open(cfg->book)) return 0;
+    if (cfg->weights && !pattern_open(cfg->weights)) return 0;
+    return tt_init(cfg->hash_mb);
+}
+
+// 상대 차례 동안의 백그라운드 탐색
+typedef struct Ponder {
+    pthread_t thread;
+    bool      running;
+    Position  pos;
+    int       side;         // 이 국면에서 둘 차례 (보통 상대)
+    int       depth;        // 탐색이 끝난 뒤 채워진다
+    uint64_t  nodes;
+} Ponder;
+
+static Ponder ponder;
+
+static void *ponder_main(void *arg) {
+    Ponder *p = (Ponder *)arg;
+    Move best;
+    search_root(&p->pos, p->side, 0, 0, &best);
+    p->depth = g_stats.depth;
+    p->nodes = g_stats.nodes;
+    return NULL;
+}
+
+void engine_ponder_start(const cJSON *board_json, char me) {
+    if (!g_config.ponder || g_config.mode != ENGINE_SEARCH) return;
+    engine_ponder_stop();
+
+    parse_board(board_json, &ponder.pos);
+    ponder.side = side_index(me) ^ 1;
+    // 상대가 패스해야 하면 우리 차례를 미리 본다
+    MoveList moves;
+    if (gather_moves(&ponder.pos, ponder.side, &moves) == 0) ponder.side ^= 1;
+    ponder.depth = 0;
+    ponder.nodes = 0;
+    ponder.running = pthread_create(&ponder.thread, NULL, ponder_main, &ponder) == 0;
+}
+
+void engine_ponder_stop(void) {
+    if (!ponder.running) return;
+    search_abort(true);
+    pthread_join(ponder.thread, NULL);
+    search_abort(false);
+    ponder.running = false;
+}
+
+// 턴 사이에 남겨 두는 예측: 우리가 둔 뒤의 국면과, PV가 예상한 상대 응수까지 둔 국면
+// 다음 your_turn의 보드를 이것과 비교해서 상대의 실제 응수를 찾고,
+// 예측이 맞았으면 남은 PV를 치환표에 다시 심어 첫 반복들이 치환표 수를 따라가게 한다
+typedef struct Prediction {
+    bool     valid;
+    Position after;         // 우리 수를 둔 뒤 (상대 차례)
+    int      side;          // 우리
+    bool     has_reply;
+    Position pos;           // 예상한 상대 응수까지 둔 뒤 (우리 차례)
+    Move     pv[64];        // pos부터 이어지는 PV
+    int      pv_len;
+} Prediction;
+
+static Prediction predicted;
+
+static bool same_position(const Position *a, const Position *b) {
+    return a->bb[0] == b->bb[0] && a->bb[1] == b->bb[1] && a->empty == b->empty;
+}
+
+static int position_diff(const Position *a, const Position *b) {
+    return popcount64((a->bb[0] ^ b->bb[0]) | (a->bb[1] ^ b->bb[1]) | (a->empty ^ b->empty));
+}
+
+// 예측과 받은 국면을 비교해서 g_stats에 남기고, 맞았으면 남은 PV를 치환표에 심는다
+static void match_prediction(const Position *pos, int side) {
+    g_stats.predict = -1;
+    g_stats.reply = MOVE_NONE;
+    if (!predicted.valid || predicted.side != side) return;
+
+    // 상대의 실제 응수 (패스면 MOVE_NONE 그대로)
+    MoveList moves;
+    int n = gather_moves(&predicted.after, side ^ 1, &moves);
+    for (int i = 0; i < n; i++) {
+        Position p = predicted.after;
+        apply_move(&p, moves[i], side ^ 1);
+        if (same_position(&p, pos)) {
+            g_stats.reply = moves[i];
+            break;
+        }
+    }
+
+    if (!predicted.has_reply) return;
+    g_stats.predict_diff = position_diff(&predicted.pos, pos);
+    g_stats.predict = g_stats.predict_diff == 0;
+    if (!g_stats.predict) return;
+
+    // 치환표에서 밀려난 PV 수만 다시 넣는다 (깊이 0이라 컷에는 쓰이지 않고 수 정렬에만 쓰인다)
+    Position p = *pos;
+    int s = side;
+    for (int i = 0; i < predicted.pv_len; i++) {
+        Move mv = predicted.pv[i];
+        if (mv != MOVE_NONE) {
+            if (!is_valid_move(&p, mv, s)) break;
+            uint64_t key = position_hash(&p, s);
+            TTEntry e;
+            if (!tt_probe(key, &e) || e.move == MOVE_NONE) tt_store(key, 0, 0, BOUND_UPPER, mv);
+            apply_move(&p, mv, s);
+        }
+        s ^= 1;
+    }
+}
+
+// 이번 탐색의 수와 PV로 다음 턴의 예측을 만든다
+static void save_prediction(const Position *pos, int side, bool found, Move best) {
+    predicted.valid = true;
+    predicted.side = side;
+    predicted.after = *pos;
+    if (found) apply_move(&predicted.after, best, side);
+
+    // PV가 우리 수로 시작하고 상대 응수까지 있어야 예측할 수 있다
+    predicted.has_reply = false;
+    predicted.pv_len = 0;
+    if (!found || g_config.mode != ENGINE_SEARCH) return;
+    if (g_stats.pv_len < 2 || g_stats.pv[0] != best) return;
+    Move reply = g_stats.pv[1];
+    predicted.pos = predicted.after;
+    if (reply != MOVE_NONE) {
+        if (!is_valid_move(&predicted.pos, reply, side ^ 1)) return;
+        apply_move(&predicted.pos, reply, side ^ 1);
+    }
+    predicted.has_reply = true;
+    predicted.pv_len = g_stats.pv_len - 2;
+    memcpy(predicted.pv, &g_stats.pv[2], predicted.pv_len * sizeof(Move));
+}
+
+void generate_move(const cJSON *board_json, double timeout, int *sx, int *sy, int *tx, int *ty, char me) {
+    bool pondered = ponder.running;
+    engine_ponder_stop();
+
+    Position pos;
+    parse_board(board_json, &pos);
+    int side = side_index(me);
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.ponder_hit = -1;
+    if (pondered) {
+        g_stats.ponder_depth = ponder.depth;
+        g_stats.ponder_nodes = ponder.nodes;
+        TTEntry e;
+        if (tt_probe(position_hash(&pos, side), &e)) g_stats.ponder_hit = e.depth;
+    }
+    match_prediction(&pos, side);
+
+    Move best = MOVE_NONE;
+    int found = 0;
+    g_stats.endgame = -1;
+    double start = now_sec();
+    if (book_probe(&pos, side, &best, &g_stats.score)) {
+        found = 1;
+        g_stats.book_hit = 1;
+    } else if (g_config.mode == ENGINE_SEARCH && popcount64(pos.empty) <= g_config.endgame) {
+        // 증명된 결과만 쓴다. 한도까지만 읽은 수는 말 개수로 평가한 것이므로 버리고 탐색으로 넘긴다
+        // (탐색 몫을 남기도록 솔버는 쓸 수 있는 시간의 절반까지만)
+        double eg_timeout = timeout > 0 ? TIME_MARGIN + (timeout - TIME_MARGIN) * 0.5 : 0;
+        Move mv;
+        int diff, exact = 0;
+        if (endgame_solve(&pos, side, eg_timeout, &mv, &diff, &exact) && exact) {
+            best = mv;
+            found = 1;
+            g_stats.endgame_score = diff;
+            g_stats.score = diff > 0 ? SCORE_WIN + diff : diff < 0 ? -SCORE_WIN + diff : 0;
+        }
+        g_stats.endgame = exact;
+    }
+    if (!found) {
+        if (g_config.mode == ENGINE_GREEDY) {
+            found = choose_greedy(&pos, side, &best);
+        } else if (g_config.mode == ENGINE_MCTS) {
+            if (timeout > 0) {
+                timeout -= now_sec() - start;
+                if (timeout <= 0) timeout = TIME_MIN;
+            }
+            found = mcts_root(&pos, side, timeout, &best);
+        } else {
+            // 시간 제한이 없으면 깊이 제한이라도 둔다
+            int depth = g_config.depth;
+            if (timeout <= 0 && depth == 0) depth = DEFAULT_DEPTH;
+            // 종반 솔버가 실패했으면 남은 시간만 쓴다 (search_root가 TIME_MIN은 보장)
+            if (timeout > 0) {
+                timeout -= now_sec() - start;
+                if (timeout <= 0) timeout = TIME_MIN;
+            }
+            found = search_root(&pos, side, depth, timeout, &best);
+        }
+    }
+    save_prediction(&pos, side, found, best);
+    if (!found) {
+        *sx = *sy = *tx = *ty = 0;
+        return;
+    }
+
+    *sx = move_from(best) / SIZE + 1;
+    *sy = move_from(best) % SIZE + 1;
+    *tx = move_to(best) / SIZE + 1;
+    *ty = move_to(best) % SIZE + 1;
+}
@@ -0,0 +1,361 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "cjson/cJSON.h"
+
+#define SIZE 8
+
+// 한 국면에서 나올 수 있는 수의 상한
+// 복제는 도착 칸마다 하나라 빈칸 수 E 이하, 점프는 말마다 8개 이하이면서 빈칸마다 8개 이하
+// 말 P + 빈칸 E <= 64에서 E + 8 * min(P, E)가 가장 큰 때는 P = E = 32: 32 + 8 × 32
+#define MAX_MOVES (SIZE * SIZE / 2 * 9)
+
+// 패턴 평가용 칸 묶음 (N-tuple): 꼭짓점 3x3 4개 + 가장자리 줄 4개
+// 칸 상태는 3진수 한 자리 (0 = 빈칸 또는 '#', 1 = 'R', 2 = 'B')
+// 같은 모양의 묶음은 꼭짓점/가장자리 쪽에서 시작하는 같은 칸 순서로 인덱스를 만들어 가중치 표를 같이 쓴다
+#define N_PATTERNS      8
+#define PATTERN_CORNERS 4           // pat[0..3] = 3x3, pat[4..7] = 가장자리
+#define CORNER_SIZE     19683       // 3^9
+#define EDGE_SIZE       6561        // 3^8
+
+// 비트보드: 칸 번호 sq = r * SIZE + c, bit sq가 켜져 있으면 해당 칸 점유
+// bb[0] = 'R', bb[1] = 'B', empty = '.' ('#' 칸은 어디에도 속하지 않음)
+// count[], key(Zobrist 해시, 둘 차례 제외), pat[](패턴 인덱스)는 make_move/unmake_move가 갱신
+typedef struct Position {
+    uint64_t bb[2];
+    uint64_t empty;
+    uint64_t key;
+    int      count[2];
+    uint16_t pat[N_PATTERNS];
+} Position;
+
+// 수 하나 = 16비트: bit 0-5 출발 칸, bit 6-11 도착 칸, bit 12 점프
+// 패스나 "수 없음"은 MOVE_NONE
+typedef uint16_t Move;
+
+#define MOVE_JUMP 0x1000
+#define MOVE_NONE ((Move)0xffff)
+
+static inline int  move_from(Move m)    { return m & 63; }
+static inline int  move_to(Move m)      { return (m >> 6) & 63; }
+static inline bool move_is_jump(Move m) { return m & MOVE_JUMP; }
+
+// 고정 크기 수 목록 (스택에 두고 힙 할당 없이 쓴다)
+template <int CAP>
+struct FixedMoveList {
+    Move m[CAP];
+    int  n;
+
+    Move &operator[](int i) { return m[i]; }
+    const Move &operator[](int i) const { return m[i]; }
+};
+
+typedef FixedMoveList<MAX_MOVES> MoveList;
+
+// 8방향 델타
+static constexpr int dr[8] = { -1, -1, -1,  0, 1, 1, 1,  0 };
+static constexpr int dc[8] = { -1,  0,  1,  1, 1, 0, -1, -1 };
+
+// 칸별 이웃 테이블 (컴파일 시간에 생성)
+// ring1 = 거리 1 (복제), ring2 = 가로/세로/대각선 2칸 (점프)
+struct SquareTables {
+    uint64_t ring1[SIZE * SIZE];
+    uint64_t ring2[SIZE * SIZE];
+    uint64_t reach[SIZE * SIZE];        // ring1 | ring2
+    uint8_t  edge_bonus[SIZE * SIZE];   // 꼭짓점 3, 모서리 1
+};
+
+constexpr SquareTables build_square_tables() {
+    SquareTables t{};
+    for (int sq = 0; sq < SIZE * SIZE; sq++) {
+        int r = sq / SIZE, c = sq % SIZE;
+        for (int f = 0; f < 8; f++) {
+            for (int k = 1; k <= 2; k++) {
+                int nr = r + dr[f] * k, nc = c + dc[f] * k;
+                if (nr < 0 || nr >= SIZE || nc < 0 || nc >= SIZE) continue;
+                int n = nr * SIZE + nc;
+                if (k == 1) t.ring1[sq] |= 1ULL << n;
+                else        t.ring2[sq] |= 1ULL << n;
+            }
+        }
+        t.reach[sq] = t.ring1[sq] | t.ring2[sq];
+        int edge = (r == 0 || r == SIZE - 1) + (c == 0 || c == SIZE - 1);
+        t.edge_bonus[sq] = (edge == 2) ? 3 : edge;
+    }
+    return t;
+}
+
+inline constexpr SquareTables SQ = build_square_tables();
+
+static_assert(__builtin_popcountll(SQ.ring1[0]) == 3 && __builtin_popcountll(SQ.ring2[0]) == 3, "corner neighbors");
+static_assert(__builtin_popcountll(SQ.ring1[3 * SIZE + 3]) == 8 && __builtin_popcountll(SQ.ring2[3 * SIZE + 3]) == 8,
+              "center neighbors");
+
+// from, to는 0..63. 점프 여부는 칸 테이블에서 (from -> to가 닿지 않는 수면 복제로 표시된다)
+static inline Move move_pack(int from, int to) {
+    return (Move)(from | to << 6 | (int)((SQ.ring2[from] >> to) & 1) << 12);
+}
+
+// 칸별로 속한 패턴 묶음과 그 안에서의 자릿값 (꼭짓점 칸은 3x3 하나와 가장자리 둘)
+struct PatternMap {
+    uint8_t  n[SIZE * SIZE];
+    uint8_t  id[SIZE * SIZE][3];
+    uint16_t pow[SIZE * SIZE][3];
+};
+
+constexpr PatternMap build_pattern_map() {
+    PatternMap m{};
+    for (int k = 0; k < PATTERN_CORNERS; k++) {
+        bool bottom = k & 2, right = k & 1;
+        int p = 1;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                int sq = (bottom ? SIZE - 1 - i : i) * SIZE + (right ? SIZE - 1 - j : j);
+                m.id[sq][m.n[sq]] = (uint8_t)k;
+                m.pow[sq][m.n[sq]++] = (uint16_t)p;
+                p *= 3;
+            }
+        }
+    }
+    // 위, 아래, 왼쪽, 오른쪽 줄
+    for (int k = 0; k < 4; k++) {
+        int p = 1;
+        for (int i = 0; i < SIZE; i++) {
+            int sq = k == 0 ? i : k == 1 ? (SIZE - 1) * SIZE + i : k == 2 ? i * SIZE : i * SIZE + SIZE - 1;
+            m.id[sq][m.n[sq]] = (uint8_t)(PATTERN_CORNERS + k);
+            m.pow[sq][m.n[sq]++] = (uint16_t)p;
+            p *= 3;
+        }
+    }
+    return m;
+}
+
+inline constexpr PatternMap PATTERNS = build_pattern_map();
+
+static_assert(PATTERNS.n[0] == 3 && PATTERNS.n[SIZE + 1] == 1 && PATTERNS.n[3 * SIZE + 3] == 0, "pattern membership");
+
+// Zobrist 키 (컴파일 시간에 splitmix64로 생성)
+struct ZobristTables {
+    uint64_t piece[2][SIZE * SIZE];
+    uint64_t flip[SIZE * SIZE];         // piece[0] ^ piece[1]
+    uint64_t side;                      // 'B' 차례일 때 xor
+};
+
+constexpr uint64_t splitmix64(uint64_t &x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristTables build_zobrist() {
+    ZobristTables z{};
+    uint64_t seed = 0x41544158ULL;
+    for (int s = 0; s < 2; s++)
+        for (int sq = 0; sq < SIZE * SIZE; sq++) z.piece[s][sq] = splitmix64(seed);
+    for (int sq = 0; sq < SIZE * SIZE; sq++) z.flip[sq] = z.piece[0][sq] ^ z.piece[1][sq];
+    z.side = splitmix64(seed);
+    return z;
+}
+
+inline constexpr ZobristTables ZOBRIST = build_zobrist();
+
+// 둘 차례까지 포함한 해시
+static inline uint64_t position_hash(const Position *pos, int side) {
+    return side ? pos->key ^ ZOBRIST.side : pos->key;
+}
+
+// '#' 칸 배치의 해시 (Zobrist 키는 말만 보므로 막힌 칸 배치가 다른 보드를 구분하지 못한다)
+static inline uint64_t layout_hash(const Position *pos) {
+    uint64_t blocked = ~(pos->bb[0] | pos->bb[1] | pos->empty);
+    blocked ^= blocked >> 33;
+    blocked *= 0xff51afd7ed558ccdULL;
+    blocked ^= blocked >> 33;
+    blocked *= 0xc4ceb9fe1a85ec53ULL;
+    blocked ^= blocked >> 33;
+    return blocked;
+}
+
+// 엔진 통계 (generate_move 호출마다 초기화)
+typedef struct EngineStats {
+    uint64_t gen_calls;     // gather_moves 호출 수
+    uint64_t gen_moves;     // 생성된 수
+    uint64_t clone_dups;    // 생성하지 않은 중복 복제 수
+    uint64_t nodes;         // 탐색한 노드 수
+    int      depth;         // 완료한 탐색 깊이
+    int      score;         // 선택한 수의 탐색 점수
+    uint64_t tt_probes;     // 치환표 조회 수
+    uint64_t tt_hits;       // 치환표에서 찾은 수
+    uint64_t tt_cutoffs;    // 치환표 값으로 바로 끝낸 노드 수
+    uint64_t cutoffs;       // beta 컷 수
+    uint64_t cut_first;     // 첫 번째 수에서 난 beta 컷
+    uint64_t cut_hash;      // 치환표 수로 난 beta 컷
+    uint64_t cut_killer;    // 킬러 수로 난 beta 컷
+    uint64_t iter_nodes[64];    // 반복 심화 깊이별 노드 수 (iter_nodes[d-1])
+    uint64_t pvs_researches;    // null window를 넘어 다시 탐색한 수
+    uint64_t asp_fail_high;     // aspiration window 위로 벗어난 횟수
+    uint64_t asp_fail_low;      // aspiration window 아래로 벗어난 횟수
+    Move     pv[64];            // 마지막으로 완료한 깊이의 PV
+    int      pv_len;
+    int      threads;           // 탐색에 쓴 스레드 수
+    double   seconds;           // 탐색 시간
+    uint64_t thread_splits[64]; // 스레드별 만든 분기점 수 (-smp ybwc)
+    uint64_t thread_steals[64]; // 스레드별 훔친 분기점 수
+    double   thread_idle[64];   // 스레드별 일 없이 기다린 시간 (초)
+    int      ponder_depth;      // 상대 차례에 미리 탐색한 깊이 (0이면 안 함)
+    uint64_t ponder_nodes;
+    int      ponder_hit;        // 받은 국면이 치환표에 남아 있던 깊이 (-1이면 없음)
+    int      reuse_depth;       // 치환표의 루트 결과를 이어받아 시작한 깊이 (0이면 처음부터)
+    int      predict;           // 지난 턴 PV의 상대 응수 예측: 1 적중, 0 빗나감, -1 예측 없음
+    int      predict_diff;      // 예측한 국면과 다른 칸 수
+    Move     reply;             // 상대가 실제로 둔 수 (모르면 MOVE_NONE)
+    int      book_hit;          // 오프닝북에서 수를 찾았으면 1
+    int      endgame;           // 종반 솔버 결과: 1 증명됨 (이 수를 둠), 0 증명 못 해 탐색으로 넘김, -1 쓰지 않음
+    int      endgame_score;     // 증명된 최종 말 차이
+    uint64_t playouts;          // -engine mcts 플레이아웃 수
+    uint32_t mcts_nodes;        // 트리에 쓴 노드 수
+    int      mcts_depth;        // 선택이 내려간 가장 깊은 트리 깊이
+    double   win_rate;          // 고른 수의 플레이아웃 승률
+} EngineStats;
+
+// 스레드마다 따로 (탐색이 끝나면 도우미 스레드의 카운터를 메인 스레드 것에 합친다)
+extern thread_local EngineStats g_stats;
+
+// 수 선택 방식
+enum { ENGINE_GREEDY, ENGINE_SEARCH, ENGINE_MCTS };
+
+// 멀티스레드 탐색 방식
+enum { SMP_LAZY, SMP_YBWC };
+
+typedef struct EngineConfig {
+    int mode;       // -engine greedy|search|mcts
+    int depth;      // -depth N (search 모드 최대 깊이, 0이면 시간으로만 제한)
+    int hash_mb;    // -hash MB (치환표 크기)
+    int aspiration; // -aspiration N (aspiration window 반폭, 0이면 사용 안 함)
+    int threads;    // -threads N (탐색 스레드 수)
+    int smp;        // -smp lazy|ybwc
+    int ponder;     // -ponder on|off (상대 차례에 미리 탐색)
+    const char *book;   // -book FILE (오프닝북, 없으면 NULL)
+    int endgame;    // -endgame N (search 모드에서 빈칸이 N 이하이면 종반 솔버, 0이면 사용 안 함)
+    const char *weights;    // -weights FILE (패턴 평가 가중치, 없으면 말 개수 차이)
+} EngineConfig;
+
+// -endgame 기본값
+#define DEFAULT_ENDGAME 12
+
+// timeout이 없을 때 쓰는 탐색 깊이
+#define DEFAULT_DEPTH 5
+
+extern EngineConfig g_config;
+
+// make_move가 남기는 되돌리기 정보 (뒤집힌 칸)
+typedef struct Undo {
+    uint64_t flips;
+    uint64_t key;
+    uint16_t pat[N_PATTERNS];
+} Undo;
+
+// 'R' -> 0, 'B' -> 1
+static inline int side_index(char player) { return player == 'B'; }
+
+static inline int popcount64(uint64_t b) { return __builtin_popcountll(b); }
+
+static inline int pop_lsb(uint64_t *b) {
+    int sq = __builtin_ctzll(*b);
+    *b &= *b - 1;
+    return sq;
+}
+
+// 칸 sq의 3진수 상태가 delta만큼 바뀐 것을 패턴 인덱스에 반영
+static inline void pattern_update(uint16_t *pat, int sq, int delta) {
+    for (int i = 0; i < PATTERNS.n[sq]; i++) pat[PATTERNS.id[sq][i]] += delta * PATTERNS.pow[sq][i];
+}
+
+static inline void make_move(Position *pos, Move mv, int side, Undo *u) {
+    int to_sq = move_to(mv);
+    uint64_t to = 1ULL << to_sq;
+    uint64_t flips = SQ.ring1[to_sq] & pos->bb[side ^ 1];
+    u->flips = flips;
+    u->key = pos->key;
+    memcpy(u->pat, pos->pat, sizeof(pos->pat));
+    uint64_t key = pos->key ^ ZOBRIST.piece[side][to_sq];
+    // 상대 말 -> 내 말: 'R'(1) <-> 'B'(2)
+    int own = side + 1, flip_delta = side ? 1 : -1;
+    pattern_update(pos->pat, to_sq, own);
+    if (move_is_jump(mv)) {
+        // 점프: 출발 칸을 비움
+        int from_sq = move_from(mv);
+        uint64_t from = 1ULL << from_sq;
+        pos->bb[side] ^= from;
+        pos->empty |= from;
+        key ^= ZOBRIST.piece[side][from_sq];
+        pattern_update(pos->pat, from_sq, -own);
+    } else {
+        pos->count[side]++;
+    }
+    pos->bb[side] |= to | flips;
+    pos->bb[side ^ 1] ^= flips;
+    pos->empty &= ~to;
+    int n = popcount64(flips);
+    pos->count[side] += n;
+    pos->count[side ^ 1] -= n;
+    while (flips) {
+        int sq = pop_lsb(&flips);
+        key ^= ZOBRIST.flip[sq];
+        if (PATTERNS.n[sq]) pattern_update(pos->pat, sq, flip_delta);
+    }
+    pos->key = key;
+}
+
+static inline void unmake_move(Position *pos, Move mv, int side, const Undo *u) {
+    uint64_t to = 1ULL << move_to(mv);
+    if (move_is_jump(mv)) {
+        uint64_t from = 1ULL << move_from(mv);
+        pos->bb[side] |= from;
+        pos->empty &= ~from;
+    } else {
+        pos->count[side]--;
+    }
+    pos->bb[side] &= ~(to | u->flips);
+    pos->bb[side ^ 1] |= u->flips;
+    pos->empty |= to;
+    int n = popcount64(u->flips);
+    pos->count[side] -= n;
+    pos->count[side ^ 1] += n;
+    pos->key = u->key;
+    memcpy(pos->pat, u->pat, sizeof(pos->pat));
+}
+
+// 문자열 8줄("R", "B", ".", "#")로 국면 구성
+void position_load(Position *pos, const char *const rows[SIZE]);
+
+int  gather_moves(const Position *pos, int side, MoveList *moves);
+void apply_move(Position *pos, Move mv, int side);
+int  count_pieces(const Position *pos, int side);
+int  is_valid_move(const Position *pos, Move mv, int side);
+int  is_safe_jump(const Position *pos, Move mv, int side);
+int  calc_greedy_value(const Position *pos, Move mv, int side);
+int  calc_friend_count(const Position *pos, int to, int side);
+int  evaluate_five_greedy(Position *pos, Move mv, int me);
+int  move_type(const Position *pos, Move mv, int side);
+int  choose_greedy(Position *pos, int side, Move *out);
+
+// 옵션을 모두 읽은 뒤 한 번 호출 (치환표 할당, 오프닝북 열기). 실패하면 0
+int  engine_init(const EngineConfig *cfg);
+
+// 명령행 옵션 하나를 처리하면 1, 모르는 옵션이거나 값이 잘못되면 0
+int  engine_parse_option(EngineConfig *cfg, const char *flag, const char *value);
+
+// JSON 보드 -> 비트보드 변환 후 수 선택 (좌표는 1-based)
+// timeout은 서버가 준 제한 시간(초), 0 이하이면 시간 제한 없음
+void generate_move(const cJSON *board_json, double timeout, int *sx, int *sy, int *tx, int *ty, char me);
+
+// -ponder on이면 우리가 둔 뒤의 보드(move_ok)로 상대 차례 동안 백그라운드 탐색을 시작한다
+// 상대의 모든 응수 뒤 국면이 치환표에 남으므로 다음 generate_move는 데워진 표에서 시작한다
+// generate_move가 먼저 멈추므로 따로 부르지 않아도 되지만, 게임이 끝나면 engine_ponder_stop
+void engine_ponder_start(const cJSON *board_json, char me);
+void engine_ponder_stop(void);
+
+#endif
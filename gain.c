@@ -0,0 +1,129 @@
+// gain.c
+#include "gain.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define NOT_A 0xfefefefefefefefeULL    // 0열 제외
+#define NOT_H 0x7f7f7f7f7f7f7f7fULL    // 7열 제외
+
+// 칸마다 이웃한 b의 말 수를 비트 평면으로: 칸 sq의 수 = sum(bit sq of p[k]) << k
+static inline void ring1_planes(uint64_t b, uint64_t p[4]) {
+    // bit sq of x[d] = 방향 d 이웃 칸의 b 비트
+    uint64_t x[8] = {
+        b << 8,                 // 위 (sq - 8)
+        b >> 8,                 // 아래 (sq + 8)
+        (b >> 1) & NOT_H,       // 오른쪽 (sq + 1)
+        (b << 1) & NOT_A,       // 왼쪽 (sq - 1)
+        (b << 7) & NOT_H,       // 오른쪽 위 (sq - 7)
+        (b << 9) & NOT_A,       // 왼쪽 위 (sq - 9)
+        (b >> 9) & NOT_H,       // 오른쪽 아래 (sq + 9)
+        (b >> 7) & NOT_A,       // 왼쪽 아래 (sq + 7)
+    };
+    // 전가산기 트리: 3 + 3 + 2개를 먼저 더하고 자리올림끼리 다시 더한다
+    uint64_t s0 = x[0] ^ x[1] ^ x[2], c0 = (x[0] & x[1]) | (x[2] & (x[0] ^ x[1]));
+    uint64_t s1 = x[3] ^ x[4] ^ x[5], c1 = (x[3] & x[4]) | (x[5] & (x[3] ^ x[4]));
+    uint64_t s2 = x[6] ^ x[7],        c2 = x[6] & x[7];
+    uint64_t ca = (s0 & s1) | (s2 & (s0 ^ s1));             // 1의 자리 올림 (2)
+    uint64_t u  = c0 ^ c1 ^ c2,       cb = (c0 & c1) | (c2 & (c0 ^ c1));
+    uint64_t cc = u & ca;                                   // 2의 자리 올림 (4)
+    p[0] = s0 ^ s1 ^ s2;
+    p[1] = u ^ ca;
+    p[2] = cb ^ cc;
+    p[3] = cb & cc;
+}
+
+#if defined(__AVX2__)
+
+// 32비트를 32바이트로: 바이트 i는 비트 i가 켜져 있으면 weight, 아니면 0
+static inline __m256i expand32(uint32_t m, __m256i weight) {
+    const __m256i shuf = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                          2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit = _mm256_set1_epi64x(0x8040201008040201LL);
+    __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)m), shuf);
+    v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+    return _mm256_and_si256(v, weight);
+}
+
+void ring1_counts(uint64_t b, uint8_t out[64]) {
+    uint64_t p[4];
+    ring1_planes(b, p);
+    for (int half = 0; half < 2; half++) {
+        __m256i sum = _mm256_setzero_si256();
+        for (int k = 0; k < 4; k++) {
+            uint32_t m = (uint32_t)(p[k] >> (32 * half));
+            sum = _mm256_or_si256(sum, expand32(m, _mm256_set1_epi8((char)(1 << k))));
+        }
+        _mm256_storeu_si256((__m256i *)(out + 32 * half), sum);
+    }
+}
+
+#elif defined(__SSE2__)
+
+// 평면 하나의 64비트를 64바이트로 펼쳐 out에 더한다 (바이트 sq는 비트 sq가 켜져 있으면 weight)
+// SSE2에는 pshufb가 없으므로 unpack으로 바이트 j를 8번씩 복제한다
+static inline void expand64(uint64_t m, __m128i weight, __m128i out[4]) {
+    const __m128i bit = _mm_set1_epi64x(0x8040201008040201LL);
+    __m128i v  = _mm_cvtsi64_si128((long long)m);
+    __m128i v8 = _mm_unpacklo_epi8(v, v);                   // b0 b0 b1 b1 .. b7 b7
+    __m128i lo = _mm_unpacklo_epi16(v8, v8);                // b0 x4 .. b3 x4
+    __m128i hi = _mm_unpackhi_epi16(v8, v8);                // b4 x4 .. b7 x4
+    __m128i q[4] = {
+        _mm_unpacklo_epi32(lo, lo), _mm_unpackhi_epi32(lo, lo),
+        _mm_unpacklo_epi32(hi, hi), _mm_unpackhi_epi32(hi, hi),
+    };
+    for (int i = 0; i < 4; i++) {
+        __m128i t = _mm_cmpeq_epi8(_mm_and_si128(q[i], bit), bit);
+        out[i] = _mm_or_si128(out[i], _mm_and_si128(t, weight));
+    }
+}
+
+void ring1_counts(uint64_t b, uint8_t out[64]) {
+    uint64_t p[4];
+    ring1_planes(b, p);
+    __m128i sum[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+    for (int k = 0; k < 4; k++) expand64(p[k], _mm_set1_epi8((char)(1 << k)), sum);
+    for (int i = 0; i < 4; i++) _mm_storeu_si128((__m128i *)(out + 16 * i), sum[i]);
+}
+
+#elif defined(__ARM_NEON)
+
+// 평면 하나의 64비트를 64바이트로 펼쳐 out에 더한다
+static inline void expand64(uint64_t m, uint8x16_t weight, uint8x16_t out[4]) {
+    static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bit = vld1q_u8(bits);
+    for (int i = 0; i < 4; i++) {
+        uint8x16_t v = vcombine_u8(vdup_n_u8((uint8_t)(m >> (16 * i))), vdup_n_u8((uint8_t)(m >> (16 * i + 8))));
+        out[i] = vorrq_u8(out[i], vandq_u8(vtstq_u8(v, bit), weight));
+    }
+}
+
+void ring1_counts(uint64_t b, uint8_t out[64]) {
+    uint64_t p[4];
+    ring1_planes(b, p);
+    uint8x16_t sum[4] = { vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0) };
+    for (int k = 0; k < 4; k++) expand64(p[k], vdupq_n_u8((uint8_t)(1 << k)), sum);
+    for (int i = 0; i < 4; i++) vst1q_u8(out + 16 * i, sum[i]);
+}
+
+#else
+
+// 8칸씩: 곱셈으로 바이트마다 같은 8비트를 복제하고 자기 비트만 남긴 뒤 0/1로
+void ring1_counts(uint64_t b, uint8_t out[64]) {
+    uint64_t p[4];
+    ring1_planes(b, p);
+    for (int r = 0; r < 8; r++) {
+        uint64_t sum = 0;
+        for (int k = 0; k < 4; k++) {
+            uint64_t x = ((p[k] >> (8 * r)) & 0xff) * 0x0101010101010101ULL & 0x8040201008040201ULL;
+            x = ((x + 0x00406070787c7e7fULL) >> 7) & 0x0101010101010101ULL;
+            sum |= x << k;
+        }
+        for (int i = 0; i < 8; i++) out[8 * r + i] = (uint8_t)(sum >> (8 * i));
+    }
+}
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef GAIN_H
+#define GAIN_H
+
+#include <stdint.h>
+
+// out[sq] = ring1[sq] 안에 있는 b의 말 수 (0..8), 64칸을 한 번에
+// b에 상대 말을 넣으면 sq에 두었을 때 뒤집히는 말 수 (복제면 여기에 +1 = calc_greedy_value)
+//
+// 8방향으로 민 비트보드를 비트 평면 4장(1, 2, 4, 8의 자리)으로 더한 뒤
+// 평면의 비트를 바이트로 펼치는 부분만 SIMD (AVX2 / SSE2 / NEON, 그 밖에는 스칼라)
+void ring1_counts(uint64_t b, uint8_t out[64]);
+
+#endif
@@ -0,0 +1,236 @@
+// mcts.c
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "mcts.h"
+#include "search.h"
+#include "gain.h"
+
+// 자식은 아레나에 연속으로 놓인다
+// first가 0이면 아직 펼치지 않은 말단 (0번은 루트라서 자식일 수 없다), MCTS_TERMINAL이면 게임 끝
+#define MCTS_TERMINAL UINT32_MAX
+
+typedef struct MctsNode {
+    uint32_t first;     // 첫 자식 인덱스
+    uint16_t n_child;
+    Move     move;      // 부모에서 이 노드로 온 수 (패스는 MOVE_NONE)
+    uint32_t visits;
+    float    wins;      // move를 둔 쪽 기준 승점 합 (승 1, 무 0.5)
+} MctsNode;
+
+static_assert(sizeof(MctsNode) == 16, "mcts node size");
+
+// 선택 경로 길이 한도
+#define MCTS_MAX_DEPTH 128
+
+static MctsNode *nodes;
+static uint32_t  n_nodes;
+static uint64_t  rng;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift64, 0..n-1
+static inline uint32_t rand_below(uint32_t n) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (uint32_t)(((rng >> 32) * n) >> 32);
+}
+
+int mcts_init(void) {
+    if (!nodes) nodes = (MctsNode *)malloc(MCTS_MAX_NODES * sizeof(MctsNode));
+    return nodes != NULL;
+}
+
+static inline bool game_over(const Position *pos) {
+    return pos->count[0] == 0 || pos->count[1] == 0;
+}
+
+// 'R' 기준 결과: 승 1, 무 0.5, 패 0
+static inline float result(const Position *pos) {
+    int diff = pos->count[0] - pos->count[1];
+    return diff > 0 ? 1.0f : diff == 0 ? 0.5f : 0.0f;
+}
+
+// 자식을 아레나에 붙인다. 그리디 이득이 큰 순으로 놓아 처음 방문할 때 이득이 큰 수부터 고른다
+// 둘 수 없고 상대는 둘 수 있으면 패스 자식 하나. 아레나가 차면 말단으로 남긴다
+static void expand(MctsNode *nd, const Position *pos, int side) {
+    MoveList moves;
+    int n = game_over(pos) ? 0 : gather_moves(pos, side, &moves);
+    if (n == 0) {
+        MoveList opp;
+        if (game_over(pos) || gather_moves(pos, side ^ 1, &opp) == 0) {
+            nd->first = MCTS_TERMINAL;
+            return;
+        }
+        moves.m[0] = MOVE_NONE;
+        moves.n = n = 1;
+    }
+    if (n_nodes + n > MCTS_MAX_NODES) return;
+
+    MctsNode *c = &nodes[n_nodes];
+    if (moves[0] == MOVE_NONE) {
+        c[0] = { 0, 0, MOVE_NONE, 0, 0.0f };
+    } else {
+        // calc_greedy_value = caps[to] + 복제, 같으면 생성 순서대로 (삽입 정렬)
+        alignas(64) uint8_t caps[SIZE * SIZE];
+        ring1_counts(pos->bb[side ^ 1], caps);
+        int keys[MAX_MOVES];
+        for (int i = 0; i < n; i++) {
+            Move mv = moves[i];
+            int k = caps[move_to(mv)] + !move_is_jump(mv);
+            int j = i;
+            while (j > 0 && keys[j - 1] < k) {
+                keys[j] = keys[j - 1];
+                c[j] = c[j - 1];
+                j--;
+            }
+            keys[j] = k;
+            c[j] = { 0, 0, mv, 0, 0.0f };
+        }
+    }
+    nd->first = n_nodes;
+    nd->n_child = (uint16_t)n;
+    n_nodes += n;
+}
+
+// 방문하지 않은 자식이 있으면 (이득 순으로) 그것부터, 모두 방문했으면 UCT 최댓값
+static MctsNode *select_child(const MctsNode *nd) {
+    MctsNode *c = &nodes[nd->first];
+    double log_n = log((double)nd->visits);
+    MctsNode *best = c;
+    double best_u = -1.0;
+    for (int i = 0; i < nd->n_child; i++) {
+        if (c[i].visits == 0) return &c[i];
+        double u = c[i].wins / c[i].visits + MCTS_UCT_C * sqrt(log_n / c[i].visits);
+        if (u > best_u) {
+            best_u = u;
+            best = &c[i];
+        }
+    }
+    return best;
+}
+
+// pos에서 side 차례부터 끝까지 (또는 MCTS_PLAYOUT_PLY까지) 둔 결과 ('R' 기준)
+// 그리디 이득이 가장 큰 수 중 하나를 무작위로, 1/MCTS_EPSILON 확률로 아무 수나
+static float playout(Position *pos, int side) {
+    for (int ply = 0; ply < MCTS_PLAYOUT_PLY && !game_over(pos); ply++) {
+        g_stats.nodes++;
+        MoveList moves;
+        int n = gather_moves(pos, side, &moves);
+        if (n == 0) {
+            MoveList opp;
+            if (gather_moves(pos, side ^ 1, &opp) == 0) break;
+            side ^= 1;
+            continue;
+        }
+        Move mv = moves[0];
+        if (rand_below(MCTS_EPSILON) == 0) {
+            mv = moves[rand_below(n)];
+        } else {
+            alignas(64) uint8_t caps[SIZE * SIZE];
+            ring1_counts(pos->bb[side ^ 1], caps);
+            int best = -1, ties = 0;
+            for (int i = 0; i < n; i++) {
+                int g = caps[move_to(moves[i])] + !move_is_jump(moves[i]);
+                if (g > best) {
+                    best = g;
+                    ties = 1;
+                    mv = moves[i];
+                } else if (g == best && rand_below(++ties) == 0) {
+                    mv = moves[i];
+                }
+            }
+        }
+        apply_move(pos, mv, side);
+        side ^= 1;
+    }
+    return result(pos);
+}
+
+// 선택 -> 펼치기 -> 플레이아웃 -> 역전파 한 번. 선택한 경로 길이를 돌려준다
+static int iterate(const Position *root, int root_side) {
+    Position pos = *root;
+    int side = root_side;
+    uint32_t path[MCTS_MAX_DEPTH];
+    uint8_t  mover[MCTS_MAX_DEPTH];
+    int len = 0;
+    MctsNode *nd = &nodes[0];
+    path[len++] = 0;
+    while (len < MCTS_MAX_DEPTH && nd->first != MCTS_TERMINAL) {
+        if (nd->first == 0) {
+            // 첫 방문에는 펼치지 않고 바로 플레이아웃
+            if (nd->visits == 0) break;
+            expand(nd, &pos, side);
+            if (nd->first == 0 || nd->first == MCTS_TERMINAL) break;
+        }
+        nd = select_child(nd);
+        if (nd->move != MOVE_NONE) apply_move(&pos, nd->move, side);
+        mover[len] = (uint8_t)side;
+        path[len++] = (uint32_t)(nd - nodes);
+        side ^= 1;
+        g_stats.nodes++;
+    }
+
+    float r = playout(&pos, side);
+    nodes[0].visits++;
+    for (int i = 1; i < len; i++) {
+        MctsNode *p = &nodes[path[i]];
+        p->visits++;
+        p->wins += mover[i] ? 1.0f - r : r;
+    }
+    return len - 1;
+}
+
+static const MctsNode *most_visited(const MctsNode *nd) {
+    const MctsNode *c = &nodes[nd->first], *best = c;
+    for (int i = 1; i < nd->n_child; i++) {
+        if (c[i].visits > best->visits) best = &c[i];
+    }
+    return best;
+}
+
+int mcts_root(const Position *pos, int side, double timeout, Move *best) {
+    double start = now_sec();
+    double budget = timeout - TIME_MARGIN;
+    if (budget < TIME_MIN) budget = TIME_MIN;
+
+    uint64_t seed = position_hash(pos, side);
+    rng = splitmix64(seed) | 1;
+    n_nodes = 1;
+    nodes[0] = { 0, 0, MOVE_NONE, 0, 0.0f };
+    expand(&nodes[0], pos, side);
+    const MctsNode *root = &nodes[0];
+    if (root->first == MCTS_TERMINAL || nodes[root->first].move == MOVE_NONE) return 0;
+
+    g_stats.threads = 1;
+    uint64_t playouts = 0;
+    // 둘 수가 하나뿐이면 시간을 쓰지 않는다
+    while (root->n_child > 1) {
+        int d = iterate(pos, side);
+        if (d > g_stats.mcts_depth) g_stats.mcts_depth = d;
+        playouts++;
+        if (timeout > 0 ? (playouts & 63) == 0 && now_sec() - start >= budget : playouts >= MCTS_DEFAULT_PLAYOUTS)
+            break;
+    }
+
+    const MctsNode *b = most_visited(root);
+    *best = b->move;
+    g_stats.playouts = playouts;
+    g_stats.mcts_nodes = n_nodes;
+    g_stats.win_rate = b->visits ? b->wins / b->visits : 0.5;
+
+    // PV: 방문 수가 가장 많은 자식을 따라간다
+    g_stats.pv_len = 0;
+    for (const MctsNode *nd = b; g_stats.pv_len < 64; nd = most_visited(nd)) {
+        g_stats.pv[g_stats.pv_len++] = nd->move;
+        if (nd->first == 0 || nd->first == MCTS_TERMINAL || nd->visits < 2) break;
+    }
+    g_stats.seconds = now_sec() - start;
+    return 1;
+}
@@ -0,0 +1,35 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "engine.h"
+
+// -engine mcts: UCT 몬테카를로 트리 탐색
+// 선택은 UCT, 말단은 두 번째 방문 때 펼치고, 플레이아웃은 비트보드 위에서 그리디 이득
+// (calc_greedy_value)이 가장 큰 수를 두되 MCTS_EPSILON 확률로 아무 수나 둔다
+// 트리 노드는 mcts_init에서 한 번 할당한 아레나에서 잘라 쓰므로 턴마다 힙 할당이 없다
+// (아레나가 차면 더 펼치지 않고 있는 트리의 말단에서 플레이아웃만 계속한다)
+
+// 노드 아레나 크기 (노드 16바이트, 32MB)
+#define MCTS_MAX_NODES (1 << 21)
+
+// UCT 탐험 상수 (승점은 0..1)
+#define MCTS_UCT_C 0.7
+
+// 플레이아웃에서 그리디 대신 아무 수나 둘 확률 (1/N)
+#define MCTS_EPSILON 8
+
+// 점프만 오가며 끝나지 않는 플레이아웃은 이 수에서 말 개수로 끝낸다
+#define MCTS_PLAYOUT_PLY 80
+
+// timeout이 없을 때의 플레이아웃 수
+#define MCTS_DEFAULT_PLAYOUTS 20000
+
+// 노드 아레나 할당 (engine_init에서 한 번). 실패하면 0
+int mcts_init(void);
+
+// timeout(초, 서버 timeout에서 TIME_MARGIN을 뺀 만큼)을 다 쓸 때까지 탐색하고
+// 가장 많이 방문한 루트 자식을 돌려준다. 둘 수가 없으면 0
+// timeout <= 0이면 MCTS_DEFAULT_PLAYOUTS번
+int mcts_root(const Position *pos, int side, double timeout, Move *best);
+
+#endif
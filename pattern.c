@@ -0,0 +1,44 @@
+// pattern.c
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "pattern.h"
+
+const PatternWeights *g_weights;
+
+static void  *map_base;
+static size_t map_size;
+
+int pattern_open(const char *path) {
+    pattern_close();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != sizeof(PatternWeights)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+    if (memcmp(((const PatternHeader *)base)->magic, PATTERN_MAGIC, 8) != 0) {
+        munmap(base, st.st_size);
+        return 0;
+    }
+    // 말단 노드마다 표 전체를 고르게 읽으므로 미리 올려 둔다
+    madvise(base, st.st_size, MADV_WILLNEED);
+
+    map_base = base;
+    map_size = st.st_size;
+    g_weights = (const PatternWeights *)base;
+    return 1;
+}
+
+void pattern_close(void) {
+    if (map_base) munmap(map_base, map_size);
+    map_base = NULL;
+    g_weights = NULL;
+}
@@ -0,0 +1,69 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <stdint.h>
+#include "engine.h"
+
+// 패턴 평가 가중치 파일 형식 (리틀 엔디언)
+// PatternHeader 뒤에 3x3 꼭짓점 표, 가장자리 줄 표가 이어진다
+// 표의 인덱스는 둘 차례 기준 3진수 (0 = 빈칸 또는 '#', 1 = 내 말, 2 = 상대 말)
+// 점수 단위는 파일이 정한다 (piece가 말 하나의 값)
+#define PATTERN_MAGIC "ATXEVAL1"
+
+typedef struct PatternHeader {
+    char     magic[8];
+    int32_t  piece;         // 말 개수 차이 1당 점수
+    uint32_t reserved;
+} PatternHeader;
+
+typedef struct PatternWeights {
+    PatternHeader h;
+    int16_t corner[CORNER_SIZE];
+    int16_t edge[EDGE_SIZE];
+} PatternWeights;
+
+static_assert(sizeof(PatternHeader) == 16, "pattern header layout");
+static_assert(sizeof(PatternWeights) == 16 + 2 * (CORNER_SIZE + EDGE_SIZE), "pattern weights layout");
+
+// 'R'(1) <-> 'B'(2) 자리를 바꾼 인덱스 (B 차례일 때 표를 찾는 데 쓴다)
+struct PatternSwap {
+    uint16_t idx[CORNER_SIZE];
+};
+
+constexpr PatternSwap build_pattern_swap() {
+    PatternSwap t{};
+    for (int i = 0; i < CORNER_SIZE; i++) {
+        int s = 0, p = 1;
+        for (int v = i; v; v /= 3, p *= 3) {
+            int d = v % 3;
+            s += (d ? 3 - d : 0) * p;
+        }
+        t.idx[i] = (uint16_t)s;
+    }
+    return t;
+}
+
+inline constexpr PatternSwap PATTERN_SWAP = build_pattern_swap();
+
+// 열린 가중치 (없으면 NULL)
+extern const PatternWeights *g_weights;
+
+// 파일을 mmap으로 연다. 실패하면 0 (형식이나 크기가 맞지 않는 경우 포함)
+int  pattern_open(const char *path);
+void pattern_close(void);
+
+// 둘 차례 기준 패턴 인덱스
+static inline int pattern_index(const Position *pos, int side, int i) {
+    return side ? PATTERN_SWAP.idx[pos->pat[i]] : pos->pat[i];
+}
+
+// 말 개수 차이 * piece + 패턴 8개의 가중치 합 (side 기준). 가중치가 열려 있어야 한다
+static inline int pattern_eval(const Position *pos, int side) {
+    const PatternWeights *w = g_weights;
+    int score = w->h.piece * (pos->count[side] - pos->count[side ^ 1]);
+    for (int i = 0; i < PATTERN_CORNERS; i++) score += w->corner[pattern_index(pos, side, i)];
+    for (int i = PATTERN_CORNERS; i < N_PATTERNS; i++) score += w->edge[pattern_index(pos, side, i)];
+    return score;
+}
+
+#endif
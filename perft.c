@@ -0,0 +1,211 @@
+// perft.c
+// 수 생성 검증/벤치마크: 정해진 국면에서 깊이 N까지의 말단 수를 세어 알려진 값과 비교한다
+// gather_moves / make_move / unmake_move만 쓰므로 수 생성을 바꿀 때마다 정확성과 속도의 기준이 된다
+//
+// 세는 규칙 (서버와 같다)
+//   - 복제는 도착 칸마다 한 수, 점프는 출발-도착 쌍마다 한 수 (gather_moves와 같음)
+//   - 둘 수 없고 상대는 둘 수 있으면 패스가 한 수
+//   - 한쪽 말이 없거나 양쪽 모두 둘 수 없으면 게임 끝: 깊이가 남아 있으면 말단으로 세지 않는다
+//
+// -bulk: 깊이 1에서 수를 두지 않고 생성한 수를 그대로 더한다
+// -hash MB: (국면, 둘 차례, 남은 깊이)별 결과를 표에 남겨 같은 국면을 다시 세지 않는다
+#ifdef PERFT_STANDALONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "engine.h"
+
+// 기대값은 엔진과 따로 짠 단순 배열 구현(칸마다 24방향을 모두 보는 방식)으로 구했다
+typedef struct PerftCase {
+    const char *name;
+    const char *board;
+    char        side;
+    int         n;
+    uint64_t    expected[8];    // expected[d - 1]
+} PerftCase;
+
+static const PerftCase CASES[] = {
+    { "start", "R......B/......../......../......../......../......../......../B......R", 'R',
+      5, { 12, 144, 2520, 43844, 986424 } },
+    { "blocks", "R......B/......../..#..#../......../......../..#..#../......../B......R", 'R',
+      5, { 10, 100, 1440, 20680, 387272 } },
+    { "walled", "R#.....B/##....../......../...##.../...##.../......../......##/B.....#R", 'B',
+      5, { 12, 72, 1224, 15304, 320776 } },
+    { "midgame", "R..B..BR/.RR..B../..RB.#../.BB.R.../...RR.B./..#.BB../.R....B./B..R...R", 'R',
+      4, { 62, 4008, 253037, 15781778 } },
+    { "pass", "RBB...../BBB...../BBB...../......../......../......../......../........", 'R',
+      5, { 1, 31, 31, 923, 6795 } },
+    { "endgame", "RRBBRRBB/BBRRBBRR/RRBB.RBB/BBRRBBRR/RRB.RRBB/BBRRBBRR/RRBBRR.B/BBRRBBRR", 'B',
+      6, { 12, 132, 1248, 10492, 88739, 689024 } },
+};
+
+#define N_CASES ((int)(sizeof(CASES) / sizeof(CASES[0])))
+
+// 해시 엔트리: key는 국면 키 ^ 남은 깊이, count의 위 8비트에 깊이
+typedef struct PerftEntry {
+    uint64_t key;
+    uint64_t data;
+} PerftEntry;
+
+static PerftEntry *table;
+static uint64_t    table_mask;
+static bool        bulk;
+
+// 깊이마다 다른 키 (Zobrist 키에 그대로 xor하면 깊이끼리 겹치므로 섞는다)
+static inline uint64_t depth_key(int depth) {
+    uint64_t x = 0x70657266ULL + depth;
+    return splitmix64(x);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s [-depth N] [-bulk on|off] [-hash MB] [-pos NAME]\n"
+            "          [-board R......B/......../... -side R|B]\n"
+            "  기본은 내장 국면 전부를 알려진 깊이까지. -board를 주면 그 국면만 (비교 없이)\n"
+            "Example:\n"
+            "  %s -depth 6 -bulk on -hash 64\n",
+            progname, progname);
+}
+
+static inline bool game_over(const Position *pos) {
+    return pos->count[0] == 0 || pos->count[1] == 0;
+}
+
+static uint64_t perft(Position *pos, int side, int depth) {
+    if (depth == 0) return 1;
+    if (game_over(pos)) return 0;
+
+    PerftEntry *e = NULL;
+    uint64_t key = 0;
+    if (table) {
+        key = position_hash(pos, side) ^ depth_key(depth);
+        e = &table[key & table_mask];
+        if (e->key == key && (int)(e->data >> 56) == depth) return e->data & ((1ULL << 56) - 1);
+    }
+
+    MoveList moves;
+    int cnt = gather_moves(pos, side, &moves);
+    uint64_t nodes = 0;
+    if (cnt == 0) {
+        MoveList opp;
+        if (gather_moves(pos, side ^ 1, &opp) > 0) nodes = perft(pos, side ^ 1, depth - 1);
+    } else if (bulk && depth == 1) {
+        nodes = cnt;
+    } else {
+        for (int i = 0; i < cnt; i++) {
+            Undo u;
+            make_move(pos, moves[i], side, &u);
+            nodes += perft(pos, side ^ 1, depth - 1);
+            unmake_move(pos, moves[i], side, &u);
+        }
+    }
+
+    if (e) {
+        e->key = key;
+        e->data = (uint64_t)depth << 56 | nodes;
+    }
+    return nodes;
+}
+
+static bool table_init(int mb) {
+    uint64_t n = 1;
+    while (n * 2 * sizeof(PerftEntry) <= (uint64_t)mb << 20) n *= 2;
+    table = (PerftEntry *)calloc(n, sizeof(PerftEntry));
+    table_mask = n - 1;
+    return table != NULL;
+}
+
+// 국면 하나를 깊이 1..max_depth로 센다. 기대값과 다르면 0
+// (Zobrist 키가 '#' 칸을 보지 않으므로 국면이 바뀔 때마다 해시를 비운다)
+static int run_case(const char *name, const char *board, int side, int max_depth,
+                    const uint64_t *expected, int n_expected) {
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) rows[i] = board + i * (SIZE + 1);
+    Position pos;
+    position_load(&pos, rows);
+    if (table) memset(table, 0, (table_mask + 1) * sizeof(PerftEntry));
+
+    int ok = 1;
+    for (int d = 1; d <= max_depth; d++) {
+        double start = now_sec();
+        uint64_t nodes = perft(&pos, side, d);
+        double sec = now_sec() - start;
+        printf("[perft] %-8s 깊이 %d: %12llu  %8.3f초  %8.2f Mnps", name, d, (unsigned long long)nodes, sec,
+               sec > 0 ? nodes / sec / 1e6 : 0.0);
+        if (d <= n_expected) {
+            bool match = nodes == expected[d - 1];
+            printf("  %s", match ? "OK" : "FAIL");
+            if (!match) printf(" (기대 %llu)", (unsigned long long)expected[d - 1]);
+            ok &= match;
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    int depth = 0, hash_mb = 0;
+    const char *only = NULL, *board = NULL;
+    char side_ch = 'R';
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "-depth") == 0)      depth = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-hash") == 0)  hash_mb = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-pos") == 0)   only = argv[i + 1];
+        else if (strcmp(argv[i], "-board") == 0) board = argv[i + 1];
+        else if (strcmp(argv[i], "-side") == 0)  side_ch = argv[i + 1][0];
+        else if (strcmp(argv[i], "-bulk") == 0 && strcmp(argv[i + 1], "on") == 0)  bulk = true;
+        else if (strcmp(argv[i], "-bulk") == 0 && strcmp(argv[i + 1], "off") == 0) bulk = false;
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (depth < 0 || hash_mb < 0 || (side_ch != 'R' && side_ch != 'B') ||
+        (board && (strlen(board) != SIZE * (SIZE + 1) - 1 || depth == 0))) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (hash_mb > 0 && !table_init(hash_mb)) {
+        fprintf(stderr, "해시 할당 실패 (%d MB)\n", hash_mb);
+        return 1;
+    }
+    printf("[perft] bulk %s, 해시 %d MB\n", bulk ? "on" : "off", hash_mb);
+
+    double start = now_sec();
+    int ok = 1, ran = 0;
+    if (board) {
+        ok = run_case("board", board, side_index(side_ch), depth, NULL, 0);
+        ran = 1;
+    } else {
+        for (int i = 0; i < N_CASES; i++) {
+            const PerftCase *c = &CASES[i];
+            if (only && strcmp(only, c->name) != 0) continue;
+            ok &= run_case(c->name, c->board, side_index(c->side), depth ? depth : c->n, c->expected, c->n);
+            ran++;
+        }
+    }
+    if (!ran) {
+        fprintf(stderr, "국면 없음: %s\n", only);
+        return 1;
+    }
+    uint64_t total = g_stats.gen_moves;
+    double sec = now_sec() - start;
+    printf("[perft] %s, 생성 %llu수, %.3f초 (%.2f M수/초)\n", ok ? "모두 일치" : "불일치 있음",
+           (unsigned long long)total, sec, sec > 0 ? total / sec / 1e6 : 0.0);
+    free(table);
+    return !ok;
+}
+#endif
@@ -0,0 +1,91 @@
+// pool.c
+#include <stdint.h>
+#include <pthread.h>
+#include "pool.h"
+
+#define POOL_MAX 64
+
+static pthread_t       threads_[POOL_MAX];
+static int             n_threads = 1;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  wake = PTHREAD_COND_INITIALIZER;    // 새 작업
+static pthread_cond_t  done = PTHREAD_COND_INITIALIZER;    // 작업 스레드가 손을 뗌
+
+// 현재 작업 (lock 아래에서 바뀐다)
+static void (*job_fn)(int, void *);
+static void *job_arg;
+static int   job_n;
+static unsigned generation;     // pool_for마다 1 증가
+// 위 32비트는 generation, 아래 32비트는 다음 i (atomic)
+// 늦게 깨어난 스레드가 지난 작업의 fn/arg로 다음 작업의 i를 가져가지 않도록 generation이 같을 때만 가져간다
+static uint64_t job_next;
+static int   busy;              // 현재 작업을 붙잡고 있는 작업 스레드 수
+
+static void run_items(void (*fn)(int, void *), void *arg, int n, unsigned gen) {
+    uint64_t cur = __atomic_load_n(&job_next, __ATOMIC_RELAXED);
+    while ((unsigned)(cur >> 32) == gen && (int)(uint32_t)cur < n) {
+        if (__atomic_compare_exchange_n(&job_next, &cur, cur + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            fn((int)(uint32_t)cur, arg);
+            cur = __atomic_load_n(&job_next, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void *worker_main(void *unused) {
+    (void)unused;
+    unsigned seen = 0;
+    pthread_mutex_lock(&lock);
+    while (1) {
+        while (generation == seen) pthread_cond_wait(&wake, &lock);
+        seen = generation;
+        void (*fn)(int, void *) = job_fn;
+        void *arg = job_arg;
+        int n = job_n;
+        busy++;
+        pthread_mutex_unlock(&lock);
+
+        run_items(fn, arg, n, seen);
+
+        pthread_mutex_lock(&lock);
+        if (--busy == 0) pthread_cond_signal(&done);
+    }
+    return NULL;
+}
+
+int pool_init(int threads) {
+    if (threads > POOL_MAX) threads = POOL_MAX;
+    while (n_threads < threads) {
+        if (pthread_create(&threads_[n_threads], NULL, worker_main, NULL) != 0) return 0;
+        pthread_detach(threads_[n_threads]);
+        n_threads++;
+    }
+    return 1;
+}
+
+int pool_threads(void) {
+    return n_threads;
+}
+
+void pool_for(int n, void (*fn)(int i, void *arg), void *arg) {
+    if (n_threads == 1 || n <= 1) {
+        for (int i = 0; i < n; i++) fn(i, arg);
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    job_fn = fn;
+    job_arg = arg;
+    job_n = n;
+    unsigned gen = ++generation;
+    __atomic_store_n(&job_next, (uint64_t)gen << 32, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    run_items(fn, arg, n, gen);
+
+    // 남은 i를 붙잡은 작업 스레드가 모두 끝날 때까지 기다린다
+    // (아직 깨어나지 않은 스레드는 나중에 깨어나면 generation이 달라 아무것도 가져가지 않는다)
+    pthread_mutex_lock(&lock);
+    while (busy > 0) pthread_cond_wait(&done, &lock);
+    pthread_mutex_unlock(&lock);
+}
@@ -0,0 +1,18 @@
+#ifndef POOL_H
+#define POOL_H
+
+// 재사용하는 작업 스레드 풀
+// 스레드는 pool_init에서 한 번 만들고, pool_for가 부를 때마다 깨어나 일을 나눠 가진다
+
+// 호출 스레드를 포함해 threads개가 일하도록 threads - 1개의 작업 스레드를 만든다
+// 이미 만든 풀이 있으면 그대로 쓴다. 실패하면 0
+int  pool_init(int threads);
+
+// 일하는 스레드 수 (호출 스레드 포함)
+int  pool_threads(void);
+
+// fn(0, arg) .. fn(n - 1, arg)를 풀의 스레드가 나눠 실행하고 모두 끝나면 돌아온다
+// 어느 i를 어느 스레드가 실행할지는 정해져 있지 않으므로 fn은 i마다 독립이어야 한다
+void pool_for(int n, void (*fn)(int i, void *arg), void *arg);
+
+#endif
@@ -0,0 +1,701 @@
+// search.c
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "search.h"
+#include "tt.h"
+#include "pattern.h"
+#include "gain.h"
+
+// 시간 관리: soft 시간이 지나면 새 깊이를 시작하지 않고,
+// hard 시간이 지나면 진행 중인 탐색을 중단한다
+// stop은 모든 탐색 스레드가 공유한다
+typedef struct TimeManager {
+    double start;
+    double soft;
+    double hard;
+    bool   stop;
+} TimeManager;
+
+static TimeManager tm;
+
+// search_abort로 바깥에서 건 중단 (tm_start가 지우지 않는다)
+static bool abort_flag;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void tm_start(double timeout) {
+    tm.start = now_sec();
+    __atomic_store_n(&tm.stop, false, __ATOMIC_RELAXED);
+    if (timeout <= 0) {
+        tm.soft = tm.hard = 1e9;
+        return;
+    }
+    double budget = timeout - TIME_MARGIN;
+    if (budget < TIME_MIN) budget = TIME_MIN;
+    tm.hard = budget;
+    tm.soft = budget * 0.5;
+}
+
+static bool tm_soft_expired(void) {
+    return now_sec() - tm.start >= tm.soft;
+}
+
+static inline bool stopped(void) {
+    return __atomic_load_n(&tm.stop, __ATOMIC_RELAXED) || __atomic_load_n(&abort_flag, __ATOMIC_RELAXED);
+}
+
+void search_abort(bool on) {
+    __atomic_store_n(&abort_flag, on, __ATOMIC_RELAXED);
+}
+
+static inline void set_stop(void) {
+    __atomic_store_n(&tm.stop, true, __ATOMIC_RELAXED);
+}
+
+// 노드 1024개마다 hard 시간 확인
+static inline bool tm_check(void) {
+    if ((g_stats.nodes & 1023) == 0 && now_sec() - tm.start >= tm.hard) set_stop();
+    return stopped();
+}
+
+int evaluate(const Position *pos, int side) {
+    if (g_weights) {
+        int score = pattern_eval(pos, side);
+        return score >= SCORE_WIN ? SCORE_WIN - 1 : score <= -SCORE_WIN ? -SCORE_WIN + 1 : score;
+    }
+    return pos->count[side] - pos->count[side ^ 1];
+}
+
+// 게임이 끝난 국면의 점수
+static int final_score(const Position *pos, int side) {
+    int diff = pos->count[side] - pos->count[side ^ 1];
+    if (diff > 0) return SCORE_WIN + diff;
+    if (diff < 0) return -SCORE_WIN + diff;
+    return 0;
+}
+
+static int has_moves(const Position *pos, int side) {
+    uint64_t pieces = pos->bb[side];
+    while (pieces) {
+        if (SQ.reach[pop_lsb(&pieces)] & pos->empty) return 1;
+    }
+    return 0;
+}
+
+// 수 정렬 키: 그리디 이득 > type (안전한 점프, 복제, 위험한 점프) > friendCnt
+// caps[to] = to 주변 상대 말 수, occ[to] = to 주변 점유된 칸 수 (노드마다 ring1_counts 한 번씩)
+static int order_key(const Position *pos, Move mv, int side, const uint8_t *caps, const uint8_t *occ) {
+    int to = move_to(mv);
+    bool clone = !move_is_jump(mv);
+    int gain = caps[to] + clone;
+    int type = clone ? 1 : (SQ.reach[move_from(mv)] & pos->bb[side ^ 1]) ? 2 : 0;
+    // 수를 두면 to 주변 상대 말은 모두 내 말이 되므로 둔 뒤의 friendCnt는
+    // to 주변의 점유된 칸 수와 같다
+    int friendCnt = occ[to] + SQ.edge_bonus[to];
+    return (gain << 8) | ((2 - type) << 5) | friendCnt;
+}
+
+// 킬러 수: 같은 ply에서 최근 beta 컷을 낸 수 2개
+// 히스토리: (from, to)별 beta 컷 점수 (depth^2 누적)
+// 정렬 정보와 PV는 탐색 스레드마다 따로 둔다
+static thread_local Move     killers[MAX_PLY + 1][2];
+static thread_local uint32_t history[SIZE * SIZE][SIZE * SIZE];
+
+#define HASH_MOVE_KEY (1 << 30)
+#define HISTORY_MAX   0x7fff
+#define KILLER_BONUS  0x8000
+
+// 치환표 수 > 그리디 이득 > type / friendCnt > 킬러 수 > 히스토리
+// (킬러를 이득보다 앞에 두면 같은 깊이에서 노드가 20% 이상 늘었다)
+static void score_moves(const Position *pos, int side, const Move *moves, int *keys, int n,
+                        Move hash_move, int ply) {
+    alignas(64) uint8_t caps[SIZE * SIZE], occ[SIZE * SIZE];
+    ring1_counts(pos->bb[side ^ 1], caps);
+    ring1_counts(pos->bb[0] | pos->bb[1], occ);
+    for (int i = 0; i < n; i++) {
+        Move mv = moves[i];
+        if (mv == hash_move) {
+            keys[i] = HASH_MOVE_KEY;
+            continue;
+        }
+        uint32_t h = history[move_from(mv)][move_to(mv)];
+        if (h > HISTORY_MAX) h = HISTORY_MAX;
+        if (mv == killers[ply][0])      h = KILLER_BONUS + 1;
+        else if (mv == killers[ply][1]) h = KILLER_BONUS;
+        int k = order_key(pos, mv, side, caps, occ);
+        keys[i] = ((k >> 8) << 24) | ((k & 0xff) << 16) | h;
+    }
+}
+
+static void update_cutoff(Move mv, int depth, int ply, int i, int key) {
+    g_stats.cutoffs++;
+    if (i == 0)                              g_stats.cut_first++;
+    if (key == HASH_MOVE_KEY)                g_stats.cut_hash++;
+    else if ((key & 0xffff) >= KILLER_BONUS) g_stats.cut_killer++;
+
+    if (killers[ply][0] != mv) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = mv;
+    }
+    history[move_from(mv)][move_to(mv)] += depth * depth;
+}
+
+// 새 탐색마다 히스토리는 절반으로 줄이고, 킬러는 2 ply 앞당긴다
+// (다음 탐색의 루트는 보통 직전 루트에서 우리 수와 상대 수를 둔 국면)
+#define KILLER_SHIFT 2
+
+static void reset_ordering(void) {
+    memmove(killers[0], killers[KILLER_SHIFT], (MAX_PLY + 1 - KILLER_SHIFT) * sizeof(killers[0]));
+    for (int i = MAX_PLY + 1 - KILLER_SHIFT; i <= MAX_PLY; i++) killers[i][0] = killers[i][1] = MOVE_NONE;
+    for (int i = 0; i < SIZE * SIZE; i++)
+        for (int j = 0; j < SIZE * SIZE; j++) history[i][j] >>= 1;
+}
+
+// i번째 자리에 남은 수 중 키가 가장 큰 수를 가져온다
+static void pick_next(Move *moves, int *keys, int i, int n) {
+    int bi = i;
+    for (int j = i + 1; j < n; j++) {
+        if (keys[j] > keys[bi]) bi = j;
+    }
+    if (bi != i) {
+        Move tm = moves[i]; moves[i] = moves[bi]; moves[bi] = tm;
+        int tk = keys[i];   keys[i] = keys[bi];   keys[bi] = tk;
+    }
+}
+
+// 삼각형 PV 테이블: pv_table[ply]는 ply부터의 최선 수순 (패스는 MOVE_NONE)
+static thread_local Move pv_table[MAX_PLY + 2][MAX_PLY + 2];
+static thread_local int  pv_len[MAX_PLY + 2];
+
+static void update_pv(int ply, Move mv) {
+    pv_table[ply][0] = mv;
+    memcpy(&pv_table[ply][1], pv_table[ply + 1], pv_len[ply + 1] * sizeof(Move));
+    pv_len[ply] = pv_len[ply + 1] + 1;
+}
+
+static int negamax(Position *pos, int side, int depth, int ply, int alpha, int beta);
+
+// ---- YBWC (-smp ybwc) ----
+// 노드의 첫 수(맏형)를 탐색한 뒤 남은 수를 분기점(split point)으로 내놓으면
+// 쉬고 있는 스레드가 훔쳐 가서 함께 탐색한다. 분기점은 만든 스레드의 덱에 쌓이고
+// 훔치는 쪽은 가장 오래된 (얕은, 일이 많은) 분기점부터 가져간다
+
+#define YBWC_MIN_DEPTH 4
+#define MAX_SPLITS     8
+
+typedef struct SplitPoint {
+    pthread_mutex_t    lock;
+    struct SplitPoint *parent;      // 만든 스레드가 그때 일하던 분기점
+    Position pos;
+    int  side, depth, ply;
+    int  alpha, beta, best;         // lock 아래에서 갱신
+    Move best_move;
+    Move moves[MAX_MOVES];
+    int  n;
+    int  next;                      // 다음에 나눠 줄 수
+    int  workers;                   // 만든 스레드를 포함해 일하는 스레드 수
+    int  cut_index;                 // beta 컷을 낸 수 (없으면 -1)
+    bool cutoff;
+    Move pv[MAX_PLY + 2];
+    int  pv_len;
+} SplitPoint;
+
+typedef struct WorkerState {
+    pthread_mutex_t lock;           // sps / n_sps 보호
+    SplitPoint      sps[MAX_SPLITS];
+    int             n_sps;
+    uint64_t        splits;
+    uint64_t        steals;
+    double          idle;
+} WorkerState;
+
+static WorkerState workers[MAX_THREADS];
+static int         n_workers;
+static int         idle_workers;
+static bool        workers_ready;
+
+static thread_local int         tl_id;
+static thread_local SplitPoint *tl_sp;
+
+static void workers_init(int threads) {
+    if (!workers_ready) {
+        for (int i = 0; i < MAX_THREADS; i++) {
+            pthread_mutex_init(&workers[i].lock, NULL);
+            for (int j = 0; j < MAX_SPLITS; j++) pthread_mutex_init(&workers[i].sps[j].lock, NULL);
+        }
+        workers_ready = true;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i].n_sps = 0;
+        workers[i].splits = workers[i].steals = 0;
+        workers[i].idle = 0;
+    }
+    n_workers = threads;
+    idle_workers = 0;
+}
+
+// 시간이 다 됐거나 이 스레드가 일하는 분기점 (또는 그 조상)에서 beta 컷이 났으면 중단
+static inline bool aborted(void) {
+    if (stopped()) return true;
+    for (SplitPoint *sp = tl_sp; sp; sp = sp->parent) {
+        if (__atomic_load_n(&sp->cutoff, __ATOMIC_RELAXED)) return true;
+    }
+    return false;
+}
+
+static bool can_split(int depth) {
+    return g_config.smp == SMP_YBWC && n_workers > 1 && depth >= YBWC_MIN_DEPTH &&
+           __atomic_load_n(&idle_workers, __ATOMIC_RELAXED) > 0 &&
+           workers[tl_id].n_sps < MAX_SPLITS;
+}
+
+// 분기점에서 수를 하나씩 받아 탐색 (만든 스레드와 훔친 스레드가 함께 호출)
+static void sp_work(SplitPoint *sp, Position *pos) {
+    int side = sp->side, depth = sp->depth, ply = sp->ply, beta = sp->beta;
+    while (1) {
+        pthread_mutex_lock(&sp->lock);
+        if (sp->cutoff || sp->next >= sp->n || aborted()) {
+            pthread_mutex_unlock(&sp->lock);
+            break;
+        }
+        int i = sp->next++;
+        int alpha = sp->alpha;
+        pthread_mutex_unlock(&sp->lock);
+
+        Move mv = sp->moves[i];
+        Undo u;
+        make_move(pos, mv, side, &u);
+        int score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -alpha - 1, -alpha);
+        if (score > alpha && score < beta && !aborted()) {
+            g_stats.pvs_researches++;
+            score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -beta, -alpha);
+        }
+        unmake_move(pos, mv, side, &u);
+        if (aborted()) break;
+
+        pthread_mutex_lock(&sp->lock);
+        if (score > sp->best) {
+            sp->best = score;
+            if (score > sp->alpha) {
+                sp->alpha = score;
+                sp->best_move = mv;
+                sp->pv_len = pv_len[ply + 1];
+                memcpy(sp->pv, pv_table[ply + 1], pv_len[ply + 1] * sizeof(Move));
+                if (score >= beta) {
+                    sp->cut_index = i;
+                    __atomic_store_n(&sp->cutoff, true, __ATOMIC_RELAXED);
+                }
+            }
+        }
+        pthread_mutex_unlock(&sp->lock);
+    }
+}
+
+// moves[first..n)를 분기점으로 내놓고 함께 탐색한다
+// *alpha, *best, *best_move를 갱신하고, beta 컷을 낸 수의 index (없으면 -1)를 돌려준다
+static int split(Position *pos, int side, int depth, int ply, int *alpha, int beta,
+                 int *best, Move *best_move, const Move *moves, int first, int n) {
+    WorkerState *w = &workers[tl_id];
+    pthread_mutex_lock(&w->lock);
+    SplitPoint *sp = &w->sps[w->n_sps];
+    sp->parent = tl_sp;
+    sp->pos = *pos;
+    sp->side = side;
+    sp->depth = depth;
+    sp->ply = ply;
+    sp->alpha = *alpha;
+    sp->beta = beta;
+    sp->best = *best;
+    sp->best_move = *best_move;
+    memcpy(sp->moves, moves + first, (n - first) * sizeof(Move));
+    sp->n = n - first;
+    sp->next = 0;
+    sp->workers = 1;
+    sp->cut_index = -1;
+    sp->cutoff = false;
+    sp->pv_len = -1;
+    __atomic_store_n(&w->n_sps, w->n_sps + 1, __ATOMIC_RELAXED);
+    w->splits++;
+    pthread_mutex_unlock(&w->lock);
+
+    tl_sp = sp;
+    sp_work(sp, pos);
+
+    // 더 이상 훔쳐 가지 못하게 덱에서 내리고 남은 도우미를 기다린다
+    pthread_mutex_lock(&w->lock);
+    __atomic_store_n(&w->n_sps, w->n_sps - 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&w->lock);
+    double t0 = now_sec();
+    while (__atomic_load_n(&sp->workers, __ATOMIC_ACQUIRE) > 1) sched_yield();
+    w->idle += now_sec() - t0;
+    tl_sp = sp->parent;
+
+    if (sp->pv_len >= 0) {
+        pv_table[ply][0] = sp->best_move;
+        memcpy(&pv_table[ply][1], sp->pv, sp->pv_len * sizeof(Move));
+        pv_len[ply] = sp->pv_len + 1;
+    }
+    *alpha = sp->alpha;
+    *best = sp->best;
+    *best_move = sp->best_move;
+    return sp->cut_index < 0 ? -1 : first + sp->cut_index;
+}
+
+// 다른 스레드의 덱에서 가장 오래된, 아직 수가 남은 분기점을 찾아 참여한다
+static SplitPoint *steal(void) {
+    for (int k = 1; k < n_workers; k++) {
+        WorkerState *v = &workers[(tl_id + k) % n_workers];
+        if (__atomic_load_n(&v->n_sps, __ATOMIC_RELAXED) == 0) continue;
+        SplitPoint *found = NULL;
+        pthread_mutex_lock(&v->lock);
+        for (int i = 0; i < v->n_sps && !found; i++) {
+            SplitPoint *sp = &v->sps[i];
+            pthread_mutex_lock(&sp->lock);
+            if (!sp->cutoff && sp->next < sp->n) {
+                sp->workers++;
+                found = sp;
+            }
+            pthread_mutex_unlock(&sp->lock);
+        }
+        pthread_mutex_unlock(&v->lock);
+        if (found) return found;
+    }
+    return NULL;
+}
+
+// 도우미 스레드: 탐색이 끝날 때까지 분기점을 훔쳐서 일한다
+static void idle_loop(void) {
+    WorkerState *w = &workers[tl_id];
+    __atomic_add_fetch(&idle_workers, 1, __ATOMIC_RELAXED);
+    double t0 = now_sec();
+    while (!stopped()) {
+        SplitPoint *sp = steal();
+        if (!sp) {
+            sched_yield();
+            continue;
+        }
+        __atomic_sub_fetch(&idle_workers, 1, __ATOMIC_RELAXED);
+        w->idle += now_sec() - t0;
+        w->steals++;
+
+        Position pos = sp->pos;
+        tl_sp = sp;
+        sp_work(sp, &pos);
+        tl_sp = NULL;
+        pthread_mutex_lock(&sp->lock);
+        __atomic_sub_fetch(&sp->workers, 1, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&sp->lock);
+
+        __atomic_add_fetch(&idle_workers, 1, __ATOMIC_RELAXED);
+        t0 = now_sec();
+    }
+    w->idle += now_sec() - t0;
+}
+
+static int negamax(Position *pos, int side, int depth, int ply, int alpha, int beta) {
+    g_stats.nodes++;
+    pv_len[ply] = 0;
+    if (tm_check() || (tl_sp && aborted())) return 0;
+
+    if (pos->empty == 0 || pos->count[side] == 0 || pos->count[side ^ 1] == 0) {
+        return final_score(pos, side);
+    }
+    if (depth == 0) return evaluate(pos, side);
+
+    uint64_t key = position_hash(pos, side);
+    Move hash_move = MOVE_NONE;
+    TTEntry te;
+    g_stats.tt_probes++;
+    if (tt_probe(key, &te)) {
+        g_stats.tt_hits++;
+        hash_move = te.move;
+        if (te.depth >= depth) {
+            int v = te.score;
+            if (te.bound == BOUND_EXACT ||
+                (te.bound == BOUND_LOWER && v >= beta) ||
+                (te.bound == BOUND_UPPER && v <= alpha)) {
+                g_stats.tt_cutoffs++;
+                return v;
+            }
+        }
+    }
+
+    MoveList list;
+    int keys[MAX_MOVES];
+    int n = gather_moves(pos, side, &list);
+    if (n == 0) {
+        // 패스: 상대도 둘 수 없으면 게임 종료
+        if (!has_moves(pos, side ^ 1)) return final_score(pos, side);
+        int score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -beta, -alpha);
+        update_pv(ply, MOVE_NONE);
+        return score;
+    }
+    Move *moves = list.m;
+    score_moves(pos, side, moves, keys, n, hash_move, ply);
+
+    int alpha_orig = alpha;
+    int best = -SCORE_INF;
+    Move best_move = MOVE_NONE;
+    for (int i = 0; i < n; i++) {
+        pick_next(moves, keys, i, n);
+        Undo u;
+        make_move(pos, moves[i], side, &u);
+        int score;
+        if (i == 0) {
+            score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -beta, -alpha);
+        } else {
+            // PVS: 첫 수 이후는 null window로 확인하고 alpha를 넘을 때만 다시 탐색
+            score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && score < beta && !aborted()) {
+                g_stats.pvs_researches++;
+                score = -negamax(pos, side ^ 1, depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+        unmake_move(pos, moves[i], side, &u);
+        if (aborted()) return 0;
+
+        if (score > best) {
+            best = score;
+            if (score > alpha) {
+                alpha = score;
+                best_move = moves[i];
+                update_pv(ply, moves[i]);
+                if (alpha >= beta) {
+                    update_cutoff(moves[i], depth, ply, i, keys[i]);
+                    break;
+                }
+            }
+        }
+
+        // 맏형을 탐색했으면 남은 수를 쉬고 있는 스레드와 나눈다
+        if (i == 0 && n > 2 && can_split(depth)) {
+            for (int j = 1; j < n; j++) pick_next(moves, keys, j, n);
+            int cut = split(pos, side, depth, ply, &alpha, beta, &best, &best_move, moves, 1, n);
+            if (aborted()) return 0;
+            if (cut >= 0) update_cutoff(moves[cut], depth, ply, cut, keys[cut]);
+            break;
+        }
+    }
+
+    int bound = best >= beta ? BOUND_LOWER : best > alpha_orig ? BOUND_EXACT : BOUND_UPPER;
+    tt_store(key, depth, best, bound, best_move);
+    return best;
+}
+
+// 반복 심화 1수 탐색 (alpha, beta 창 안에서). 중단되면 해당 깊이의 결과는 버린다
+// alpha를 넘은 수가 없으면 *best_i는 그대로
+static int search_depth(Position *pos, int side, int depth, int alpha, int beta,
+                        Move *moves, int n, int *best_i) {
+    int best = -SCORE_INF;
+    pv_len[0] = 0;
+    for (int i = 0; i < n; i++) {
+        Undo u;
+        make_move(pos, moves[i], side, &u);
+        int score;
+        if (i == 0) {
+            score = -negamax(pos, side ^ 1, depth - 1, 1, -beta, -alpha);
+        } else {
+            score = -negamax(pos, side ^ 1, depth - 1, 1, -alpha - 1, -alpha);
+            if (score > alpha && score < beta && !stopped()) {
+                g_stats.pvs_researches++;
+                score = -negamax(pos, side ^ 1, depth - 1, 1, -beta, -alpha);
+            }
+        }
+        unmake_move(pos, moves[i], side, &u);
+        if (stopped()) break;
+
+        if (score > best) {
+            best = score;
+            if (score > alpha) {
+                alpha = score;
+                *best_i = i;
+                update_pv(0, moves[i]);
+                if (alpha >= beta) break;
+            }
+        }
+
+        if (i == 0 && n > 2 && can_split(depth)) {
+            Move bm = moves[*best_i];
+            int old_alpha = alpha;
+            split(pos, side, depth, 0, &alpha, beta, &best, &bm, moves, 1, n);
+            if (alpha > old_alpha) {
+                for (int j = 0; j < n; j++) {
+                    if (moves[j] == bm) *best_i = j;
+                }
+            }
+            break;
+        }
+    }
+    return best;
+}
+
+// 루트 탐색 작업: 메인 스레드(id 0)와 Lazy SMP 도우미 스레드가 하나씩 가진다
+typedef struct RootJob {
+    Position    pos;
+    int         side;
+    int         id;
+    int         max_depth;
+    int         start_depth;    // 치환표에 남은 루트 결과가 있으면 그 깊이부터
+    int         start_score;
+    MoveList    moves;
+    Move        best;
+    EngineStats stats;      // 도우미 스레드가 끝날 때 자기 g_stats를 복사
+    pthread_t   thread;
+} RootJob;
+
+static RootJob jobs[MAX_THREADS];
+
+// 반복 심화. 도우미 스레드는 홀수 id면 한 수 더 깊게 시작해서
+// 메인 스레드와 다른 깊이를 탐색하며 공유 치환표를 채운다
+// 이전 턴이나 pondering에서 이 루트를 이미 탐색했으면 그 깊이부터 다시 시작한다
+static void iterate(RootJob *job) {
+    Position *pos = &job->pos;
+    int side = job->side, n = job->moves.n;
+    Move *moves = job->moves.m;
+
+    int prev = job->start_score;
+    for (int depth = job->start_depth + (job->id & 1); depth <= job->max_depth; depth++) {
+        int best_i = 0;
+        uint64_t start_nodes = g_stats.nodes;
+
+        // 직전 깊이 점수 주변의 aspiration window로 시작해서 벗어나면 넓힌다
+        int delta = g_config.aspiration;
+        int alpha = -SCORE_INF, beta = SCORE_INF;
+        if (depth >= ASPIRATION_MIN_DEPTH && delta > 0 && abs(prev) < SCORE_WIN) {
+            alpha = prev - delta;
+            beta = prev + delta;
+        }
+        int score;
+        while (1) {
+            score = search_depth(pos, side, depth, alpha, beta, moves, n, &best_i);
+            if (stopped()) break;
+            if (score <= alpha && alpha > -SCORE_INF) {
+                g_stats.asp_fail_low++;
+                alpha = (delta *= 2) >= SCORE_WIN ? -SCORE_INF : score - delta;
+            } else if (score >= beta && beta < SCORE_INF) {
+                g_stats.asp_fail_high++;
+                beta = (delta *= 2) >= SCORE_WIN ? SCORE_INF : score + delta;
+            } else {
+                break;
+            }
+        }
+        if (stopped()) break;
+        g_stats.iter_nodes[depth - 1] = g_stats.nodes - start_nodes;
+
+        // 완료된 깊이의 최선 수를 다음 반복에서 가장 먼저 탐색
+        Move bm = moves[best_i];
+        memmove(&moves[1], &moves[0], best_i * sizeof(Move));
+        moves[0] = bm;
+        job->best = bm;
+        prev = score;
+        g_stats.depth = depth;
+        g_stats.score = score;
+        g_stats.pv_len = pv_len[0];
+        memcpy(g_stats.pv, pv_table[0], pv_len[0] * sizeof(Move));
+        tt_store(position_hash(pos, side), depth, score, BOUND_EXACT, bm);
+
+        if (job->id == 0 && (n == 1 || tm_soft_expired())) break;
+    }
+}
+
+static void *helper_main(void *arg) {
+    RootJob *job = (RootJob *)arg;
+    tl_id = job->id;
+    tl_sp = NULL;
+    reset_ordering();
+    if (g_config.smp == SMP_YBWC) idle_loop();
+    else                          iterate(job);
+    job->stats = g_stats;
+    return NULL;
+}
+
+// 도우미 스레드의 카운터를 메인 스레드 통계에 더한다
+static void merge_stats(EngineStats *dst, const EngineStats *src) {
+    dst->gen_calls      += src->gen_calls;
+    dst->gen_moves      += src->gen_moves;
+    dst->clone_dups     += src->clone_dups;
+    dst->nodes          += src->nodes;
+    dst->tt_probes      += src->tt_probes;
+    dst->tt_hits        += src->tt_hits;
+    dst->tt_cutoffs     += src->tt_cutoffs;
+    dst->cutoffs        += src->cutoffs;
+    dst->cut_first      += src->cut_first;
+    dst->cut_hash       += src->cut_hash;
+    dst->cut_killer     += src->cut_killer;
+    dst->pvs_researches += src->pvs_researches;
+}
+
+int search_root(Position *pos, int side, int max_depth, double timeout, Move *best) {
+    RootJob *main_job = &jobs[0];
+    Move *moves = main_job->moves.m;
+    int keys[MAX_MOVES];
+    int n = gather_moves(pos, side, &main_job->moves);
+    if (n == 0) return 0;
+    Move hash_move = MOVE_NONE;
+    TTEntry te;
+    int start_depth = 1, start_score = 0;
+    if (tt_probe(position_hash(pos, side), &te) && te.move != MOVE_NONE) {
+        hash_move = te.move;
+        if (te.bound == BOUND_EXACT && te.depth > 1) {
+            start_depth = te.depth;
+            start_score = te.score;
+        }
+    }
+    reset_ordering();
+    score_moves(pos, side, moves, keys, n, hash_move, 0);
+    for (int i = 0; i < n; i++) pick_next(moves, keys, i, n);
+
+    tm_start(timeout);
+    tt_new_search();
+    if (max_depth <= 0) max_depth = MAX_PLY;
+    if (start_depth > max_depth) start_depth = max_depth;
+    g_stats.reuse_depth = start_depth > 1 ? start_depth : 0;
+
+    main_job->pos = *pos;
+    main_job->side = side;
+    main_job->id = 0;
+    main_job->max_depth = max_depth;
+    main_job->start_depth = start_depth;
+    main_job->start_score = start_score;
+    main_job->best = moves[0];
+
+    int threads = g_config.threads;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    workers_init(threads);
+    tl_id = 0;
+    tl_sp = NULL;
+    int started = 1;
+    for (int i = 1; i < threads; i++) {
+        RootJob *job = &jobs[i];
+        memcpy(job, main_job, sizeof(RootJob));
+        job->id = i;
+        memset(&job->stats, 0, sizeof(job->stats));
+        if (pthread_create(&job->thread, NULL, helper_main, job) != 0) break;
+        started++;
+    }
+
+    iterate(main_job);
+
+    set_stop();
+    for (int i = 1; i < started; i++) {
+        pthread_join(jobs[i].thread, NULL);
+        merge_stats(&g_stats, &jobs[i].stats);
+    }
+    g_stats.threads = started;
+    g_stats.seconds = now_sec() - tm.start;
+    for (int i = 0; i < started; i++) {
+        g_stats.thread_splits[i] = workers[i].splits;
+        g_stats.thread_steals[i] = workers[i].steals;
+        g_stats.thread_idle[i] = workers[i].idle;
+    }
+
+    *best = main_job->best;
+    return 1;
+}
@@ -0,0 +1,36 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "engine.h"
+
+#define SCORE_INF 30000
+#define SCORE_WIN 10000     // 승패가 확정된 국면 (+ 최종 말 차이)
+
+#define MAX_PLY 64
+
+// -threads 상한
+#define MAX_THREADS 64
+
+// 이 깊이부터 aspiration window 사용 (폭은 -aspiration)
+#define ASPIRATION_MIN_DEPTH 3
+
+// 서버 timeout(초)에서 빼 두는 여유: 네트워크 지연과 LED 표시 대기(0.1초)
+#define TIME_MARGIN 0.3
+#define TIME_MIN    0.05
+
+// 말 개수 차이 (side 기준). -weights로 가중치를 열었으면 패턴 평가 (SCORE_WIN 안쪽으로 자름)
+int evaluate(const Position *pos, int side);
+
+// 반복 심화 negamax alpha-beta 탐색. 둘 수가 없으면 0
+// max_depth <= 0이면 깊이 제한 없음, timeout <= 0이면 시간 제한 없음
+// 시간이 다 되면 마지막으로 끝까지 탐색한 깊이의 수를 돌려준다
+// g_config.threads > 1이면 Lazy SMP: 도우미 스레드가 같은 루트를 공유 치환표로 탐색하고
+// 결과는 메인 스레드의 것을 쓴다. -smp ybwc이면 도우미 스레드는 루트를 따로 탐색하지 않고
+// 맏형 탐색이 끝난 노드의 남은 수를 훔쳐서 탐색한다 (work stealing)
+int search_root(Position *pos, int side, int max_depth, double timeout, Move *best);
+
+// 다른 스레드에서 진행 중인 search_root를 멈춘다 (on = true)
+// false로 되돌리기 전까지는 새로 시작한 탐색도 바로 끝난다
+void search_abort(bool on);
+
+#endif
@@ -0,0 +1,494 @@
+// server.c
+// 시험용 로컬 게임 서버: 대회 서버와 같은 한 줄짜리 JSON 프로토콜로 client 두 개를 맞붙인다
+//   client -> 서버: register, move
+//   서버 -> client: register_ack, game_start, your_turn(board, timeout), move_ok, invalid_move,
+//                   pass, game_over(board, scores)
+// 규칙과 제한 시간은 서버가 검사한다. 잘못된 수나 시간 초과는 invalid_move를 보내고 그 차례를 넘긴다
+// -latency MS는 한 방향 네트워크 지연: 서버 -> client 메시지는 보낸 뒤 MS만큼 지나야 소켓에 쓰고
+// (연결마다 따로 기다리므로 broadcast도 두 client에 같은 때 닿는다), client -> 서버 메시지는
+// 도착한 뒤 MS만큼 잡아 두었다가 받는다. 제한 시간과 응답 시간은 your_turn을 보내려는 순간부터
+// 재므로 왕복 지연(2 x MS)이 그대로 들어간다. 끝나면 응답 시간과 처리량을 낸다
+#ifdef SERVER_STANDALONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include "cjson/cJSON.h"
+#include "engine.h"
+
+#define BUF_SIZE 4096
+
+// register를 기다리는 시간 (초)
+#define REGISTER_TIMEOUT 10.0
+
+// 점프만 오가며 끝나지 않는 대국은 이 수에서 말 개수로 끝낸다
+#define SERVER_MAX_PLIES 400
+
+// 받았지만 아직 읽지 않은 줄의 도착 시각을 기억하는 수 (넘치면 마지막 시각을 같이 쓴다)
+#define MAX_PENDING_LINES 64
+
+typedef struct Conn {
+    int    fd;
+    char   name[32];
+    char   buf[BUF_SIZE];
+    int    len;
+    int    late;        // 시간 초과로 넘긴 뒤 아직 도착하지 않은 move 수 (오면 버린다)
+    double line_at[MAX_PENDING_LINES];  // buf 안의 줄마다 도착 시각
+    int    n_lines;
+} Conn;
+
+// 지연을 기다리는 서버 -> client 메시지 (지연이 일정하므로 보낸 순서 = 쓸 순서)
+typedef struct Outgoing {
+    int    fd;
+    double due;
+    char  *data;
+    int    len;
+} Outgoing;
+
+static Outgoing *outbox;
+static int       out_head, out_n, out_cap;
+static double    latency;   // 한 방향 지연 (초)
+
+typedef struct ServerConfig {
+    double timeout;     // your_turn의 timeout (초)
+    int    latency_ms;  // 한 방향 지연 (서버 -> client, client -> 서버 각각)
+    int    games;
+    int    max_plies;
+    const char *board;
+} ServerConfig;
+
+// 응답 시간 기록 (your_turn을 보낸 때부터 move를 받을 때까지, 초)
+typedef struct Timings {
+    double *t;
+    int     n;
+    int     cap;
+} Timings;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s -port <port> [-timeout SEC] [-latency MS] [-games N] [-maxply N]\n"
+            "          [-board R......B/......../...]\n"
+            "  -latency MS: 방향마다 MS만큼 지연 (서버가 보낸 메시지와 client가 보낸 move 각각).\n"
+            "               timeout과 응답 시간은 your_turn을 보내는 순간부터 재므로 왕복 지연이 들어간다\n"
+            "Example:\n"
+            "  %s -port 8080 -timeout 3 -latency 20 -games 10\n",
+            progname, progname);
+}
+
+// 때가 된 메시지를 소켓에 쓴다
+static void flush_outbox(void) {
+    double now = now_sec();
+    while (out_n > 0 && outbox[out_head].due <= now) {
+        Outgoing *o = &outbox[out_head];
+        send(o->fd, o->data, o->len, 0);
+        free(o->data);
+        out_head = (out_head + 1) % out_cap;
+        out_n--;
+    }
+}
+
+// 가장 먼저 쓸 메시지의 시각 (없으면 t)
+static double next_due(double t) {
+    return out_n > 0 && outbox[out_head].due < t ? outbox[out_head].due : t;
+}
+
+// t까지 보낼 메시지를 보내며 기다린다
+static void wait_until(double t) {
+    while (1) {
+        flush_outbox();
+        double left = next_due(t) - now_sec();
+        if (left <= 0 && now_sec() >= t) return;
+        if (left > 0) usleep((useconds_t)(left * 1e6) + 1);
+    }
+}
+
+// 남은 메시지를 모두 보낸다 (연결을 닫기 전에)
+static void drain_outbox(void) {
+    while (out_n > 0) wait_until(outbox[(out_head + out_n - 1) % out_cap].due);
+}
+
+// 지연 뒤에 보내도록 줄을 outbox에 넣는다
+static int send_json(Conn *c, cJSON *obj) {
+    char *json_str = cJSON_PrintUnformatted(obj);
+    if (!json_str) return -1;
+    size_t len = strlen(json_str);
+    char *buf = (char *)malloc(len + 2);
+    if (!buf) {
+        free(json_str);
+        return -1;
+    }
+    memcpy(buf, json_str, len);
+    buf[len] = '\n';
+    free(json_str);
+    if (out_n == out_cap) {
+        int cap = out_cap ? out_cap * 2 : 64;
+        Outgoing *grown = (Outgoing *)malloc(cap * sizeof(Outgoing));
+        if (!grown) {
+            free(buf);
+            return -1;
+        }
+        for (int i = 0; i < out_n; i++) grown[i] = outbox[(out_head + i) % out_cap];
+        free(outbox);
+        outbox = grown;
+        out_cap = cap;
+        out_head = 0;
+    }
+    outbox[(out_head + out_n) % out_cap] = { c->fd, now_sec() + latency, buf, (int)len + 1 };
+    out_n++;
+    flush_outbox();
+    return (int)len + 1;
+}
+
+// 한 줄을 받아 파싱한다. 도착한 뒤 latency가 지나야 돌려준다
+// deadline(now_sec 기준)까지 받을 수 없으면 *timed_out = 1 (늦은 줄은 버퍼에 남는다), 연결이 끊기면 NULL
+static cJSON *recv_json(Conn *c, double deadline, int *timed_out) {
+    *timed_out = 0;
+    while (1) {
+        char *nl = (char *)memchr(c->buf, '\n', c->len);
+        if (nl) {
+            double ready = (c->n_lines > 0 ? c->line_at[0] : now_sec()) + latency;
+            if (ready > deadline) {
+                wait_until(deadline);
+                *timed_out = 1;
+                return NULL;
+            }
+            wait_until(ready);
+            if (c->n_lines > 0) memmove(c->line_at, c->line_at + 1, --c->n_lines * sizeof(double));
+            *nl = '\0';
+            cJSON *obj = cJSON_Parse(c->buf);
+            int used = (int)(nl - c->buf) + 1;
+            memmove(c->buf, c->buf + used, c->len - used);
+            c->len -= used;
+            if (obj) return obj;
+            continue;       // 깨진 줄은 버린다
+        }
+        if (c->len >= BUF_SIZE - 1) return NULL;
+
+        flush_outbox();
+        double now = now_sec();
+        if (now >= deadline) {
+            *timed_out = 1;
+            return NULL;
+        }
+        // 보낼 메시지가 있으면 그때 깨어난다
+        int wait_ms = (int)((next_due(deadline) - now) * 1000) + 1;
+        struct pollfd pfd = { c->fd, POLLIN, 0 };
+        int r = poll(&pfd, 1, wait_ms);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return NULL;
+        if (r == 0) continue;
+        int n = recv(c->fd, c->buf + c->len, BUF_SIZE - 1 - c->len, 0);
+        if (n <= 0) return NULL;
+        double at = now_sec();
+        for (int i = c->len; i < c->len + n; i++) {
+            if (c->buf[i] != '\n') continue;
+            if (c->n_lines < MAX_PENDING_LINES) c->n_lines++;
+            c->line_at[c->n_lines - 1] = at;
+        }
+        c->len += n;
+    }
+}
+
+static int listen_on(const char *port) {
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof hints);
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = AI_PASSIVE;
+    int status = getaddrinfo(NULL, port, &hints, &res);
+    if (status != 0) {
+        fprintf(stderr, "getaddrinfo 오류: %s\n", gai_strerror(status));
+        return -1;
+    }
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    int on = 1;
+    if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (fd < 0 || bind(fd, res->ai_addr, res->ai_addrlen) != 0 || listen(fd, 4) != 0) {
+        perror("listen 실패");
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+// 접속을 받아 register를 기다린다. 성공하면 1
+static int accept_player(int lfd, Conn *c, const ServerConfig *cfg) {
+    memset(c, 0, sizeof(*c));
+    c->fd = accept(lfd, NULL, NULL);
+    if (c->fd < 0) {
+        perror("accept 실패");
+        return 0;
+    }
+    int timed_out;
+    cJSON *msg = recv_json(c, now_sec() + REGISTER_TIMEOUT, &timed_out);
+    cJSON *type = cJSON_GetObjectItem(msg, "type");
+    cJSON *name = cJSON_GetObjectItem(msg, "username");
+    int ok = cJSON_IsString(type) && strcmp(type->valuestring, "register") == 0 && cJSON_IsString(name);
+    if (ok) {
+        strncpy(c->name, name->valuestring, sizeof(c->name) - 1);
+        cJSON *ack = cJSON_CreateObject();
+        cJSON_AddStringToObject(ack, "type", "register_ack");
+        send_json(c, ack);
+        cJSON_Delete(ack);
+        printf("[서버] register: %s\n", c->name);
+    } else {
+        printf("[서버] register 없이 접속 종료\n");
+        drain_outbox();
+        close(c->fd);
+    }
+    cJSON_Delete(msg);
+    return ok;
+}
+
+static cJSON *board_json(const Position *pos) {
+    cJSON *arr = cJSON_CreateArray();
+    for (int i = 0; i < SIZE; i++) {
+        char row[SIZE + 1];
+        for (int j = 0; j < SIZE; j++) {
+            uint64_t bit = 1ULL << (i * SIZE + j);
+            row[j] = (pos->bb[0] & bit) ? 'R' : (pos->bb[1] & bit) ? 'B' : (pos->empty & bit) ? '.' : '#';
+        }
+        row[SIZE] = '\0';
+        cJSON_AddItemToArray(arr, cJSON_CreateString(row));
+    }
+    return arr;
+}
+
+static void broadcast(Conn p[2], cJSON *obj, const ServerConfig *cfg) {
+    send_json(&p[0], obj);
+    send_json(&p[1], obj);
+}
+
+static void send_pass(Conn p[2], int who, const ServerConfig *cfg) {
+    cJSON *msg = cJSON_CreateObject();
+    cJSON_AddStringToObject(msg, "type", "pass");
+    cJSON_AddStringToObject(msg, "username", p[who].name);
+    cJSON_AddStringToObject(msg, "next_player", p[who ^ 1].name);
+    broadcast(p, msg, cfg);
+    cJSON_Delete(msg);
+}
+
+static void send_invalid(Conn *c, const char *reason, const ServerConfig *cfg) {
+    cJSON *msg = cJSON_CreateObject();
+    cJSON_AddStringToObject(msg, "type", "invalid_move");
+    cJSON_AddStringToObject(msg, "reason", reason);
+    send_json(c, msg);
+    cJSON_Delete(msg);
+}
+
+// 차례인 player의 move를 기다린다. 늦게 온 지난 move는 버린다
+// 받으면 1, 시간 초과 0, 연결 끊김 -1
+static int wait_move(Conn *c, double deadline, Move *mv) {
+    while (1) {
+        int timed_out;
+        cJSON *msg = recv_json(c, deadline, &timed_out);
+        if (!msg) return timed_out ? 0 : -1;
+        cJSON *type = cJSON_GetObjectItem(msg, "type");
+        if (!cJSON_IsString(type) || strcmp(type->valuestring, "move") != 0) {
+            cJSON_Delete(msg);
+            continue;
+        }
+        if (c->late > 0) {
+            c->late--;
+            cJSON_Delete(msg);
+            continue;
+        }
+        int v[4];
+        const char *keys[4] = { "sx", "sy", "tx", "ty" };
+        for (int i = 0; i < 4; i++) {
+            cJSON *n = cJSON_GetObjectItem(msg, keys[i]);
+            v[i] = cJSON_IsNumber(n) ? n->valueint : 0;
+        }
+        cJSON_Delete(msg);
+        bool in_range = true;
+        for (int i = 0; i < 4; i++) in_range &= v[i] >= 1 && v[i] <= SIZE;
+        *mv = in_range ? move_pack((v[0] - 1) * SIZE + v[1] - 1, (v[2] - 1) * SIZE + v[3] - 1) : MOVE_NONE;
+        return 1;
+    }
+}
+
+static void add_timing(Timings *t, double v) {
+    if (t->n == t->cap) {
+        t->cap = t->cap ? t->cap * 2 : 256;
+        t->t = (double *)realloc(t->t, t->cap * sizeof(double));
+    }
+    t->t[t->n++] = v;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+// 한 판. p[0]이 'R' (먼저 둔다). 잘못된 수 / 시간 초과 횟수를 돌려준다
+static void play_game(Conn p[2], const Position *start, const ServerConfig *cfg, Timings *tm,
+                      int *invalid, int *timeouts) {
+    Position pos = *start;
+    int side = 0, ply;
+    *invalid = *timeouts = 0;
+
+    cJSON *msg = cJSON_CreateObject();
+    cJSON_AddStringToObject(msg, "type", "game_start");
+    cJSON_AddStringToObject(msg, "first_player", p[0].name);
+    broadcast(p, msg, cfg);
+    cJSON_Delete(msg);
+
+    for (ply = 0; ply < cfg->max_plies; ply++) {
+        if (pos.count[0] == 0 || pos.count[1] == 0) break;
+        MoveList moves;
+        if (gather_moves(&pos, side, &moves) == 0) {
+            if (gather_moves(&pos, side ^ 1, &moves) == 0) break;
+            send_pass(p, side, cfg);
+            side ^= 1;
+            continue;
+        }
+
+        msg = cJSON_CreateObject();
+        cJSON_AddStringToObject(msg, "type", "your_turn");
+        cJSON_AddItemToObject(msg, "board", board_json(&pos));
+        cJSON_AddNumberToObject(msg, "timeout", cfg->timeout);
+        // 제한 시간과 응답 시간은 보내려는 순간부터 (가는 지연과 오는 지연이 모두 들어간다)
+        double sent = now_sec();
+        send_json(&p[side], msg);
+        cJSON_Delete(msg);
+
+        Move mv;
+        int r = wait_move(&p[side], sent + cfg->timeout, &mv);
+        if (r < 0) {
+            printf("[서버] %s 연결 끊김\n", p[side].name);
+            break;
+        }
+        if (r == 0) {
+            (*timeouts)++;
+            p[side].late++;
+            send_invalid(&p[side], "timeout", cfg);
+            send_pass(p, side, cfg);
+            side ^= 1;
+            continue;
+        }
+        add_timing(tm, now_sec() - sent);
+        if (!is_valid_move(&pos, mv, side)) {
+            (*invalid)++;
+            send_invalid(&p[side], "illegal", cfg);
+            send_pass(p, side, cfg);
+            side ^= 1;
+            continue;
+        }
+        apply_move(&pos, mv, side);
+
+        msg = cJSON_CreateObject();
+        cJSON_AddStringToObject(msg, "type", "move_ok");
+        cJSON_AddStringToObject(msg, "username", p[side].name);
+        cJSON_AddItemToObject(msg, "board", board_json(&pos));
+        broadcast(p, msg, cfg);
+        cJSON_Delete(msg);
+        side ^= 1;
+    }
+
+    msg = cJSON_CreateObject();
+    cJSON_AddStringToObject(msg, "type", "game_over");
+    cJSON_AddItemToObject(msg, "board", board_json(&pos));
+    cJSON *scores = cJSON_AddObjectToObject(msg, "scores");
+    cJSON_AddNumberToObject(scores, p[0].name, pos.count[0]);
+    cJSON_AddNumberToObject(scores, p[1].name, pos.count[1]);
+    broadcast(p, msg, cfg);
+    cJSON_Delete(msg);
+    printf("[서버] game_over: %s %d - %s %d (%d수, 잘못된 수 %d, 시간 초과 %d)\n", p[0].name, pos.count[0],
+           p[1].name, pos.count[1], ply, *invalid, *timeouts);
+}
+
+int main(int argc, char *argv[]) {
+    ServerConfig cfg = { 3.0, 0, 1, SERVER_MAX_PLIES,
+                         "R......B/......../......../......../......../......../......../B......R" };
+    const char *port = NULL;
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "-port") == 0)         port = argv[i + 1];
+        else if (strcmp(argv[i], "-timeout") == 0) cfg.timeout = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "-latency") == 0) cfg.latency_ms = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-games") == 0)   cfg.games = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-maxply") == 0)  cfg.max_plies = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-board") == 0)   cfg.board = argv[i + 1];
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!port || cfg.timeout <= 0 || cfg.latency_ms < 0 || cfg.games <= 0 || cfg.max_plies <= 0 ||
+        strlen(cfg.board) != SIZE * (SIZE + 1) - 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    latency = cfg.latency_ms / 1000.0;
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) rows[i] = cfg.board + i * (SIZE + 1);
+    Position start;
+    position_load(&start, rows);
+
+    // 끊긴 client에 보내다가 죽지 않도록
+    signal(SIGPIPE, SIG_IGN);
+    int lfd = listen_on(port);
+    if (lfd < 0) return 1;
+    printf("[서버] 포트 %s, timeout %.2f초, 지연 %dms, %d판\n", port, cfg.timeout, cfg.latency_ms, cfg.games);
+    fflush(stdout);
+
+    // client는 game_over를 받으면 끝나므로 판마다 두 명을 새로 받는다
+    Timings tm = { NULL, 0, 0 };
+    int total_invalid = 0, total_timeouts = 0, played = 0;
+    double start_time = 0;
+    for (int g = 0; g < cfg.games; g++) {
+        Conn p[2];
+        int n = 0;
+        while (n < 2) n += accept_player(lfd, &p[n], &cfg);
+        if (g == 0) start_time = now_sec();
+        // 판마다 먼저 두는 쪽을 바꾼다
+        if (g & 1) {
+            Conn t = p[0];
+            p[0] = p[1];
+            p[1] = t;
+        }
+        int invalid, timeouts;
+        play_game(p, &start, &cfg, &tm, &invalid, &timeouts);
+        total_invalid += invalid;
+        total_timeouts += timeouts;
+        played++;
+        drain_outbox();
+        close(p[0].fd);
+        close(p[1].fd);
+        fflush(stdout);
+    }
+    close(lfd);
+
+    double elapsed = now_sec() - start_time;
+    printf("[서버] %d판, 수 %d개, %.1f초 (%.1f수/초), 잘못된 수 %d, 시간 초과 %d\n", played, tm.n, elapsed,
+           elapsed > 0 ? tm.n / elapsed : 0.0, total_invalid, total_timeouts);
+    if (tm.n > 0) {
+        qsort(tm.t, tm.n, sizeof(double), cmp_double);
+        double sum = 0;
+        for (int i = 0; i < tm.n; i++) sum += tm.t[i];
+        printf("[서버] 응답 시간 ms: 평균 %.1f, 최소 %.1f, p50 %.1f, p95 %.1f, p99 %.1f, 최대 %.1f\n",
+               1000 * sum / tm.n, 1000 * tm.t[0], 1000 * tm.t[tm.n / 2], 1000 * tm.t[tm.n * 95 / 100],
+               1000 * tm.t[tm.n * 99 / 100], 1000 * tm.t[tm.n - 1]);
+    }
+    free(tm.t);
+    return 0;
+}
+#endif
@@ -0,0 +1,121 @@
+// tt.c
+#include <stdlib.h>
+#include <string.h>
+#include "tt.h"
+
+static TTBucket *buckets;
+static uint64_t  bucket_mask;
+static uint8_t   tt_age;
+
+int tt_init(int mb) {
+    size_t n = 1;
+    while (n * 2 * sizeof(TTBucket) <= (size_t)mb << 20) n *= 2;
+
+    free(buckets);
+    void *mem = NULL;
+    if (posix_memalign(&mem, sizeof(TTBucket), n * sizeof(TTBucket)) != 0) {
+        buckets = NULL;
+        return 0;
+    }
+    buckets = (TTBucket *)mem;
+    bucket_mask = n - 1;
+    tt_clear();
+    return 1;
+}
+
+void tt_clear(void) {
+    memset(buckets, 0, (bucket_mask + 1) * sizeof(TTBucket));
+    tt_age = 0;
+}
+
+void tt_new_search(void) {
+    tt_age = (tt_age + 1) & 0x3f;
+}
+
+static inline uint64_t pack(const TTEntry *e) {
+    return (uint64_t)(uint16_t)e->score |
+           (uint64_t)e->move << 16 |
+           (uint64_t)e->depth << 32 |
+           (uint64_t)e->bound << 40 |
+           (uint64_t)e->age << 48;
+}
+
+static inline TTEntry unpack(uint64_t d) {
+    TTEntry e;
+    e.score = (int16_t)(d & 0xffff);
+    e.move  = (Move)(d >> 16);
+    e.depth = (uint8_t)(d >> 32);
+    e.bound = (uint8_t)(d >> 40);
+    e.age   = (uint8_t)(d >> 48);
+    return e;
+}
+
+// 슬롯을 읽어서 (key, data)로. 다른 스레드가 쓰는 중이면 key가 맞지 않는다
+static inline void load_slot(const TTSlot *s, uint64_t *key, uint64_t *data) {
+    uint64_t c = __atomic_load_n(&s->check, __ATOMIC_RELAXED);
+    uint64_t d = __atomic_load_n(&s->data, __ATOMIC_RELAXED);
+    *key = c ^ d;
+    *data = d;
+}
+
+int tt_probe(uint64_t key, TTEntry *out) {
+    const TTBucket *b = &buckets[key & bucket_mask];
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        uint64_t k, d;
+        load_slot(&b->e[i], &k, &d);
+        if (k == key && d != 0) {
+            *out = unpack(d);
+            if (out->bound != BOUND_NONE) return 1;
+        }
+    }
+    return 0;
+}
+
+// 같은 키가 있으면 그 자리에, 없으면 (깊이 - 오래된 정도 × 4)가 가장 작은 엔트리를 교체
+void tt_store(uint64_t key, int depth, int score, int bound, Move best) {
+    TTBucket *b = &buckets[key & bucket_mask];
+    TTSlot *victim = &b->e[0], *empty = NULL;
+    TTEntry old = unpack(0);
+    bool same = false;
+    int victim_value = 1 << 30;
+    // 같은 키는 빈 자리보다 뒤에 있을 수 있으므로 버킷 전체를 본 뒤에 빈 자리를 쓴다
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        uint64_t k, d;
+        load_slot(&b->e[i], &k, &d);
+        TTEntry e = unpack(d);
+        if (k == key && e.bound != BOUND_NONE) {
+            victim = &b->e[i];
+            old = e;
+            same = true;
+            break;
+        }
+        if (e.bound == BOUND_NONE) {
+            if (!empty) empty = &b->e[i];
+            continue;
+        }
+        int value = e.depth - ((tt_age - e.age) & 0x3f) * 4;
+        if (value < victim_value) {
+            victim = &b->e[i];
+            victim_value = value;
+        }
+    }
+    if (!same && empty) victim = empty;
+
+    // 같은 국면의 더 깊은 결과는 얕은 결과로 덮지 않는다 (정확한 값은 예외)
+    if (same && old.age == tt_age && old.depth > depth && bound != BOUND_EXACT) {
+        return;
+    }
+
+    TTEntry e;
+    e.score = (int16_t)score;
+    e.move  = best;
+    // 최선 수를 모르면 이전에 저장된 수를 유지
+    if (best == MOVE_NONE && same) e.move = old.move;
+    e.depth = (uint8_t)depth;
+    e.bound = (uint8_t)bound;
+    e.age   = tt_age;
+
+    uint64_t d = pack(&e);
+    __atomic_store_n(&victim->check, key ^ d, __ATOMIC_RELAXED);
+    __atomic_store_n(&victim->data, d, __ATOMIC_RELAXED);
+}
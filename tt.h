@@ -0,0 +1,45 @@
+#ifndef TT_H
+#define TT_H
+
+#include <stddef.h>
+#include "engine.h"
+
+enum { BOUND_NONE, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT };
+
+// tt_probe가 돌려주는 엔트리 내용
+typedef struct TTEntry {
+    int16_t score;
+    Move    move;       // 최선 수가 없으면 MOVE_NONE
+    uint8_t depth;
+    uint8_t bound;
+    uint8_t age;
+} TTEntry;
+
+// 저장 형식: data는 TTEntry를 64비트로 묶은 값, check = key ^ data
+// 스레드 여러 개가 잠금 없이 읽고 쓰다가 두 워드가 섞이면 check가 맞지 않아 버려진다
+typedef struct TTSlot {
+    uint64_t check;
+    uint64_t data;
+} TTSlot;
+
+// 16바이트 슬롯 4개 = 캐시 라인 하나 (64바이트) 버킷
+#define TT_BUCKET_SIZE 4
+
+typedef struct alignas(64) TTBucket {
+    TTSlot e[TT_BUCKET_SIZE];
+} TTBucket;
+
+static_assert(sizeof(TTBucket) == 64, "bucket must fill one cache line");
+
+// mb 메가바이트 이하 (2의 거듭제곱 버킷 수)로 할당. 실패하면 0
+int  tt_init(int mb);
+void tt_clear(void);
+
+// 새 탐색 시작: 나이를 올려 이전 탐색의 엔트리가 먼저 교체되게 한다
+void tt_new_search(void);
+
+// 찾으면 1
+int  tt_probe(uint64_t key, TTEntry *out);
+void tt_store(uint64_t key, int depth, int score, int bound, Move best);
+
+#endif
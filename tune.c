@@ -0,0 +1,234 @@
+// tune.c
+// 기록된 국면으로 패턴 평가 가중치를 맞추는 도구 (Texel 방식)
+// 국면마다 예측 승률 sigmoid(k * 평가값)과 실제 결과의 제곱 오차를 줄이도록
+// 전체 국면에 대한 기울기로 가중치를 고친다. 기울기는 풀의 스레드가 국면을 나눠 계산한다
+// (-threads를 주지 않으면 온라인 코어 수만큼)
+//
+// 입력 파일: 한 줄에 국면 하나
+//   <보드 64글자, 위 줄부터 이어 씀> <둘 차례 R|B> <둘 차례 기준 결과 1|0.5|0>
+// 출력 파일: pattern.h의 가중치 파일 (client -weights로 읽음)
+#ifdef TUNE_STANDALONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "engine.h"
+#include "pattern.h"
+#include "pool.h"
+
+#define N_WEIGHTS  (1 + CORNER_SIZE + EDGE_SIZE)
+#define CORNER_OFS 1
+#define EDGE_OFS   (1 + CORNER_SIZE)
+
+// 국면을 나누는 조각 수. 스레드 수와 상관없이 고정해서 기울기 합산 순서가 같게 한다
+#define TUNE_CHUNKS 64
+
+// 국면 하나의 특징: 말 개수 차이와 가중치 8개의 위치 (둘 차례 기준)
+typedef struct Sample {
+    int8_t   diff;
+    float    result;
+    uint32_t idx[N_PATTERNS];
+} Sample;
+
+typedef struct Tuner {
+    const Sample *samples;
+    int           n;
+    int           chunks;
+    double        k;
+    const double *w;
+    double       *grad;     // chunks * N_WEIGHTS
+    double       *error;    // chunk별 제곱 오차 합
+} Tuner;
+
+static void print_usage(const char *progname) {
+    fprintf(stderr,
+            "Usage: %s -in <positions> -out <weights> [-epochs N] [-lr X] [-k X]\n"
+            "          [-l2 X] [-piece N] [-init <weights>] [-threads N]\n"
+            "Example:\n"
+            "  %s -in positions.txt -out eval.bin -epochs 500 -threads 4\n",
+            progname, progname);
+}
+
+// 한 줄을 읽어 Sample로. 형식이 맞지 않으면 0
+static int parse_line(const char *line, Sample *s) {
+    char board[SIZE * SIZE + 1], side_ch;
+    float result;
+    if (sscanf(line, "%64s %c %f", board, &side_ch, &result) != 3 || strlen(board) != SIZE * SIZE) return 0;
+    if (side_ch != 'R' && side_ch != 'B') return 0;
+
+    char rows_buf[SIZE][SIZE + 1];
+    const char *rows[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+        memcpy(rows_buf[i], board + i * SIZE, SIZE);
+        rows_buf[i][SIZE] = '\0';
+        rows[i] = rows_buf[i];
+    }
+    Position pos;
+    position_load(&pos, rows);
+    int side = side_ch == 'B';
+    s->diff = (int8_t)(pos.count[side] - pos.count[side ^ 1]);
+    s->result = result;
+    for (int i = 0; i < N_PATTERNS; i++) {
+        int ofs = i < PATTERN_CORNERS ? CORNER_OFS : EDGE_OFS;
+        s->idx[i] = ofs + pattern_index(&pos, side, i);
+    }
+    return 1;
+}
+
+static inline double sample_eval(const Sample *s, const double *w) {
+    double e = w[0] * s->diff;
+    for (int i = 0; i < N_PATTERNS; i++) e += w[s->idx[i]];
+    return e;
+}
+
+// chunk c가 맡은 국면의 기울기와 오차
+static void grad_task(int c, void *arg) {
+    Tuner *t = (Tuner *)arg;
+    double *g = t->grad + (size_t)c * N_WEIGHTS;
+    memset(g, 0, N_WEIGHTS * sizeof(double));
+    int lo = (int)((long long)t->n * c / t->chunks), hi = (int)((long long)t->n * (c + 1) / t->chunks);
+    double err = 0;
+    for (int i = lo; i < hi; i++) {
+        const Sample *s = &t->samples[i];
+        double p = 1.0 / (1.0 + exp(-t->k * sample_eval(s, t->w)));
+        double d = p - s->result;
+        err += d * d;
+        // d(오차)/d(평가값) = 2 * d * p * (1 - p) * k
+        double ge = 2 * d * p * (1 - p) * t->k;
+        g[0] += ge * s->diff;
+        for (int j = 0; j < N_PATTERNS; j++) g[s->idx[j]] += ge;
+    }
+    t->error[c] = err;
+}
+
+static int load_weights(const char *path, double *w) {
+    if (!pattern_open(path)) return 0;
+    w[0] = g_weights->h.piece;
+    for (int i = 0; i < CORNER_SIZE; i++) w[CORNER_OFS + i] = g_weights->corner[i];
+    for (int i = 0; i < EDGE_SIZE; i++) w[EDGE_OFS + i] = g_weights->edge[i];
+    pattern_close();
+    return 1;
+}
+
+static inline int16_t clamp16(double v) {
+    long r = lround(v);
+    return (int16_t)(r > 32767 ? 32767 : r < -32768 ? -32768 : r);
+}
+
+static int save_weights(const char *path, const double *w) {
+    PatternWeights *out = (PatternWeights *)calloc(1, sizeof(PatternWeights));
+    memcpy(out->h.magic, PATTERN_MAGIC, 8);
+    out->h.piece = (int32_t)lround(w[0]);
+    for (int i = 0; i < CORNER_SIZE; i++) out->corner[i] = clamp16(w[CORNER_OFS + i]);
+    for (int i = 0; i < EDGE_SIZE; i++) out->edge[i] = clamp16(w[EDGE_OFS + i]);
+    FILE *fp = fopen(path, "wb");
+    int ok = fp && fwrite(out, sizeof(*out), 1, fp) == 1;
+    if (fp) ok &= fclose(fp) == 0;
+    free(out);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *in = NULL, *out = NULL, *init = NULL;
+    int epochs = 300, piece = 16, threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    double lr = 1.0, k = 0.02, l2 = 1e-4;
+
+    if (argc % 2 != 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "-in") == 0)           in = argv[i + 1];
+        else if (strcmp(argv[i], "-out") == 0)     out = argv[i + 1];
+        else if (strcmp(argv[i], "-init") == 0)    init = argv[i + 1];
+        else if (strcmp(argv[i], "-epochs") == 0)  epochs = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-piece") == 0)   piece = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-threads") == 0) threads = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-lr") == 0)      lr = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "-k") == 0)       k = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "-l2") == 0)      l2 = atof(argv[i + 1]);
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!in || !out || epochs < 0 || threads < 1 || lr <= 0 || k <= 0 || l2 < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!pool_init(threads)) {
+        fprintf(stderr, "스레드 생성 실패 (%d개)\n", threads);
+        return 1;
+    }
+
+    FILE *fp = fopen(in, "r");
+    if (!fp) {
+        perror("국면 파일 열기 실패");
+        return 1;
+    }
+    int cap = 1 << 16, n = 0, skipped = 0;
+    Sample *samples = (Sample *)malloc(cap * sizeof(Sample));
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        if (n == cap) samples = (Sample *)realloc(samples, (cap *= 2) * sizeof(Sample));
+        if (parse_line(line, &samples[n])) n++;
+        else skipped++;
+    }
+    fclose(fp);
+    if (n == 0) {
+        fprintf(stderr, "%s: 읽은 국면 없음\n", in);
+        return 1;
+    }
+    printf("[튜닝] 국면 %d개 (건너뜀 %d), 스레드 %d\n", n, skipped, pool_threads());
+
+    double *w = (double *)calloc(N_WEIGHTS, sizeof(double));
+    w[0] = piece;
+    if (init && !load_weights(init, w)) {
+        fprintf(stderr, "%s: 가중치 파일이 아님\n", init);
+        return 1;
+    }
+
+    // 국면마다 나오는 패턴이 드물어서 가중치마다 보폭을 따로 맞추는 Adam을 쓴다
+    Tuner t = { samples, n, TUNE_CHUNKS, k, w, NULL, NULL };
+    t.grad = (double *)malloc((size_t)t.chunks * N_WEIGHTS * sizeof(double));
+    t.error = (double *)calloc(t.chunks, sizeof(double));
+    double *m = (double *)calloc(N_WEIGHTS, sizeof(double));
+    double *v = (double *)calloc(N_WEIGHTS, sizeof(double));
+    const double b1 = 0.9, b2 = 0.999;
+
+    for (int e = 0; e <= epochs; e++) {
+        pool_for(t.chunks, grad_task, &t);
+        double err = 0;
+        for (int c = 0; c < t.chunks; c++) err += t.error[c];
+        if (e % 10 == 0 || e == epochs) printf("[튜닝] epoch %d: 오차 %.6f\n", e, err / n);
+        if (e == epochs) break;
+
+        double c1 = 1 - pow(b1, e + 1), c2 = 1 - pow(b2, e + 1);
+        for (int i = 0; i < N_WEIGHTS; i++) {
+            double g = 0;
+            for (int c = 0; c < t.chunks; c++) g += t.grad[(size_t)c * N_WEIGHTS + i];
+            g /= n;
+            // 드물게 나오는 패턴이 표본 잡음에 끌려가지 않도록 0 쪽으로 당긴다 (말 가중치 제외)
+            if (i > 0) g += l2 * w[i];
+            m[i] = b1 * m[i] + (1 - b1) * g;
+            v[i] = b2 * v[i] + (1 - b2) * g * g;
+            w[i] -= lr * (m[i] / c1) / (sqrt(v[i] / c2) + 1e-8);
+        }
+    }
+
+    if (!save_weights(out, w)) {
+        perror("가중치 파일 쓰기 실패");
+        return 1;
+    }
+    printf("[튜닝] %s: 말 하나 %d\n", out, (int)lround(w[0]));
+    free(m);
+    free(v);
+    free(t.grad);
+    free(t.error);
+    free(w);
+    free(samples);
+    return 0;
+}
+#endif